@@ -8,6 +8,7 @@
 #include "specter/input/keyboard.h"
 #include "specter/input/mouse.h"
 #include "specter/mark/marker.h"
+#include "specter/schedule/scheduler.h"
 #include "specter/search/searcher.h"
 #include "specter/server/server.h"
 /* -------------------------------------------------------------------------- */
@@ -24,6 +25,7 @@ public:
 public:
   ~SpecterModule();
 
+  [[nodiscard]] Scheduler &getScheduler() const;
   [[nodiscard]] Server &getServer() const;
   [[nodiscard]] Marker &getMarker() const;
   [[nodiscard]] Searcher &getSearcher() const;
@@ -36,6 +38,7 @@ protected:
 private:
   static std::unique_ptr<SpecterModule> m_instance;
 
+  std::unique_ptr<Scheduler> m_scheduler;
   std::unique_ptr<Server> m_server;
   std::unique_ptr<Marker> m_marker;
   std::unique_ptr<Searcher> m_searcher;
@@ -43,6 +46,10 @@ private:
   std::unique_ptr<KeyboardController> m_keyboard_controller;
 };
 
+inline Scheduler &scheduler() {
+  return SpecterModule::getInstance().getScheduler();
+}
+
 inline Server &server() { return SpecterModule::getInstance().getServer(); }
 
 inline Marker &marker() { return SpecterModule::getInstance().getMarker(); }
@@ -0,0 +1,66 @@
+#ifndef SPECTER_OBSERVE_PREVIEW_COMPARATOR_H
+#define SPECTER_OBSERVE_PREVIEW_COMPARATOR_H
+
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QByteArray>
+#include <QImage>
+#include <QList>
+#include <QRect>
+#include <QString>
+/* ---------------------------------- Standard ------------------------------ */
+#include <optional>
+#include <utility>
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/export.h"
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* ------------------------------ ImageComparison --------------------------- */
+
+struct LIB_SPECTER_API ImageComparison {
+  bool size_matches = true;
+  double similarity = 1.0;
+  quint64 mismatched_pixels = 0;
+  QList<QRect> mismatches = {};
+  QImage diff_mask = {};
+};
+
+/* ------------------------------ ReferenceStatus --------------------------- */
+
+enum class ReferenceStatus { Added, Invalid, TooLarge };
+
+/* ------------------------------ ImageComparator --------------------------- */
+
+class LIB_SPECTER_API ImageComparator {
+  static const int cell_size;
+  static const int window_size;
+  static const qsizetype max_reference_cost;
+  static const qsizetype max_reference_size;
+
+public:
+  [[nodiscard]] static std::pair<ReferenceStatus, QString>
+  addReference(const QByteArray &data);
+  [[nodiscard]] static std::optional<QImage>
+  findReference(const QString &hash);
+
+public:
+  explicit ImageComparator(int tolerance = 0, bool diff_mask = false);
+  ~ImageComparator();
+
+  [[nodiscard]] ImageComparison
+  compare(const QImage &actual, const QImage &reference) const;
+
+private:
+  [[nodiscard]] static double similarity(const QImage &a, const QImage &b);
+  [[nodiscard]] static QList<QRect>
+  mismatches(const QList<bool> &cells, int columns, const QRect &bounds);
+
+private:
+  int m_tolerance;
+  bool m_diff_mask;
+};
+
+}// namespace specter
+
+#endif// SPECTER_OBSERVE_PREVIEW_COMPARATOR_H
@@ -0,0 +1,102 @@
+#ifndef SPECTER_OBSERVE_PREVIEW_ENCODER_H
+#define SPECTER_OBSERVE_PREVIEW_ENCODER_H
+
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QByteArray>
+#include <QImage>
+#include <QList>
+#include <QRect>
+#include <QSize>
+#include <QThreadPool>
+/* ---------------------------------- Standard ------------------------------ */
+#include <functional>
+#include <memory>
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/export.h"
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* -------------------------------- PreviewCodec ---------------------------- */
+
+enum class PreviewCodec { Png, FastPng, Jpeg, RawRgba, RawBgra };
+
+/* ------------------------------- PreviewFormat ---------------------------- */
+
+struct LIB_SPECTER_API PreviewFormat {
+  PreviewCodec codec = PreviewCodec::Png;
+  int quality = -1;
+  QSize max_size = QSize{};
+  bool delta = false;
+  int tile_size = 64;
+  int keyframe_interval = 60;
+};
+
+/* -------------------------------- PreviewTile ----------------------------- */
+
+struct LIB_SPECTER_API PreviewTile {
+  QRect rect = QRect{};
+  QByteArray data = {};
+};
+
+/* -------------------------------- PreviewFrame ---------------------------- */
+
+struct LIB_SPECTER_API PreviewFrame {
+  QByteArray data = {};
+  QSize size = QSize{};
+  PreviewCodec codec = PreviewCodec::Png;
+  bool keyframe = true;
+  QList<PreviewTile> tiles = {};
+};
+
+/* ------------------------------- PreviewEncoder --------------------------- */
+
+class LIB_SPECTER_API PreviewEncoder {
+  static const int max_thread_count;
+  static const int fast_png_quality;
+  static const int min_tile_size;
+
+public:
+  using Sink = std::function<void(const PreviewFrame &)>;
+  using BatchSink = std::function<void(QList<PreviewFrame>)>;
+
+public:
+  [[nodiscard]] static PreviewFrame
+  encode(QImage image, const PreviewFormat &format);
+  static void encode(
+    QList<QImage> images, const PreviewFormat &format, BatchSink sink);
+  [[nodiscard]] static QImage
+  decode(const QByteArray &data, const QSize &size, PreviewCodec codec);
+
+public:
+  explicit PreviewEncoder(Sink sink);
+  ~PreviewEncoder();
+
+  void setFormat(const PreviewFormat &format);
+  [[nodiscard]] PreviewFormat getFormat() const;
+
+  void encode(QImage image);
+  void requestKeyframe();
+
+  [[nodiscard]] quint64 getDroppedFrames() const;
+
+private:
+  struct State;
+  struct TileState;
+
+  [[nodiscard]] static PreviewFrame encodeDelta(
+    QImage image, const PreviewFormat &format, TileState &tile_state,
+    bool keyframe);
+  [[nodiscard]] static QByteArray
+  encodeData(QImage image, const PreviewFormat &format);
+
+  [[nodiscard]] static QThreadPool &getThreadPool();
+  static void run(const std::shared_ptr<State> &state);
+
+private:
+  std::shared_ptr<State> m_state;
+};
+
+}// namespace specter
+
+#endif// SPECTER_OBSERVE_PREVIEW_ENCODER_H
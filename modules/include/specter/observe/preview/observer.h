@@ -5,47 +5,91 @@
 #include <QByteArray>
 #include <QObject>
 #include <QPointer>
-#include <QQueue>
-#include <QTimer>
+#include <QRect>
 /* ---------------------------------- Standard ------------------------------ */
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
+#include <set>
 /* ----------------------------------- Local -------------------------------- */
 #include "specter/export.h"
+#include "specter/observe/preview/encoder.h"
+#include "specter/schedule/scheduler.h"
 #include "specter/search/query.h"
 /* -------------------------------------------------------------------------- */
 
 namespace specter {
 
+class PreviewObserverQueue;
+
 /* ------------------------------- PreviewObserver -------------------------- */
 
 class LIB_SPECTER_API PreviewObserver : public QObject {
   Q_OBJECT
 
+  static const int default_frame_interval_ms;
+
+public:
+  [[nodiscard]] static PreviewObserver *find(const QString &id);
+  [[nodiscard]] static std::shared_ptr<PreviewObserver>
+  acquire(QObject *object, const PreviewFormat &format, const QRect &region);
+
 public:
   explicit PreviewObserver();
   ~PreviewObserver() override;
 
+  [[nodiscard]] QString getId() const;
+
   void setObject(QObject *object);
   QObject *getObject() const;
 
+  void setFormat(const PreviewFormat &format);
+  [[nodiscard]] PreviewFormat getFormat() const;
+
+  void setRegion(const QRect &region);
+  [[nodiscard]] QRect getRegion() const;
+
+  void subscribe(PreviewObserverQueue *queue);
+  void unsubscribe(PreviewObserverQueue *queue);
+  void updateSubscribers();
+
+  void requestKeyframe();
+
   void start();
   void stop();
 
   [[nodiscard]] bool isObserving() const;
+  [[nodiscard]] quint64 getDroppedFrames() const;
 
 Q_SIGNALS:
-  void previewReported(const QByteArray &preview);
+  void previewReported(const PreviewFrame &preview);
+
+protected:
+  bool eventFilter(QObject *watched, QEvent *event) override;
 
 private:
   void checkForChanges();
+  void setFrameInterval(std::chrono::milliseconds frame_interval);
+
+  void watch(QObject *object);
+  void unwatch(QObject *object);
 
 private:
+  QString m_id;
   QPointer<QObject> m_object;
+  QRect m_region;
   bool m_observing;
-  QTimer *m_check_timer;
+  bool m_dirty;
+  bool m_grabbing;
+  bool m_paused;
+  std::chrono::milliseconds m_frame_interval;
+  Scheduler::TaskId m_check_task;
+  std::unique_ptr<PreviewEncoder> m_encoder;
+  std::set<PreviewObserverQueue *> m_subscribers;
 };
 
 /* ---------------------------- PreviewObserverQueue ---------------------- */
@@ -56,15 +100,33 @@ public:
   ~PreviewObserverQueue();
 
   void setObserver(PreviewObserver *observer);
+  void setNotifier(std::function<void()> notifier);
+  void setMaxRate(uint max_rate);
+  void setPaused(bool paused);
 
   [[nodiscard]] bool isEmpty() const;
-  [[nodiscard]] QByteArray popPreview();
-  [[nodiscard]] QByteArray waitPopPreview();
+  [[nodiscard]] bool isReady() const;
+  [[nodiscard]] bool isPaused() const;
+  [[nodiscard]] uint getMaxRate() const;
+  [[nodiscard]] std::chrono::milliseconds getDelay() const;
+  [[nodiscard]] quint64 getDroppedFrames() const;
+
+  [[nodiscard]] PreviewFrame popPreview();
+  [[nodiscard]] PreviewFrame waitPopPreview();
+
+private:
+  void pushPreview(const PreviewFrame &preview);
+  [[nodiscard]] PreviewFrame takePreview();
 
 private:
   PreviewObserver *m_observer;
   QMetaObject::Connection m_on_preview_reported;
-  QQueue<QByteArray> m_observed_previews;
+  std::optional<PreviewFrame> m_latest_preview;
+  quint64 m_dropped_frames;
+  bool m_seen_keyframe;
+  bool m_paused;
+  RateLimiter m_rate_limiter;
+  std::function<void()> m_notifier;
 
   mutable std::mutex m_mutex;
   std::condition_variable m_cv;
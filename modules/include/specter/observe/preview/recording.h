@@ -0,0 +1,162 @@
+#ifndef SPECTER_OBSERVE_PREVIEW_RECORDING_H
+#define SPECTER_OBSERVE_PREVIEW_RECORDING_H
+
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QList>
+#include <QRect>
+#include <QString>
+/* ---------------------------------- Standard ------------------------------ */
+#include <memory>
+#include <optional>
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/export.h"
+#include "specter/observe/preview/encoder.h"
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+class PreviewObserver;
+class PreviewObserverQueue;
+
+/* --------------------------- PreviewRecordingFormat ----------------------- */
+
+struct LIB_SPECTER_API PreviewRecordingFormat {
+  static const quint32 magic;
+  static const quint32 version;
+
+  struct Header {
+    quint32 magic;
+    quint32 version;
+    qint64 started_at;
+  };
+
+  struct RecordHeader {
+    quint32 size;
+    quint32 tile_count;
+    qint64 timestamp;
+    quint32 width;
+    quint32 height;
+    quint32 codec;
+    quint32 data_size;
+  };
+
+  struct TileHeader {
+    qint32 x;
+    qint32 y;
+    qint32 width;
+    qint32 height;
+    quint32 data_size;
+    quint32 reserved;
+  };
+
+  struct IndexEntry {
+    qint64 timestamp;
+    qint64 offset;
+  };
+
+  [[nodiscard]] static QString indexPath(const QString &path);
+};
+
+/* ------------------------------- PreviewRecorded -------------------------- */
+
+struct LIB_SPECTER_API PreviewRecorded {
+  qint64 timestamp = 0;
+  QImage image = {};
+};
+
+/* --------------------------- PreviewRecordingWriter ----------------------- */
+
+class LIB_SPECTER_API PreviewRecordingWriter {
+  static const qint64 grow_size;
+
+public:
+  explicit PreviewRecordingWriter(const QString &path);
+  ~PreviewRecordingWriter();
+
+  [[nodiscard]] bool open();
+  void close();
+
+  [[nodiscard]] bool append(const PreviewFrame &frame, qint64 timestamp);
+
+  [[nodiscard]] QString getErrorString() const;
+
+private:
+  [[nodiscard]] bool reserve(qint64 size);
+  void write(const void *data, qint64 size);
+
+private:
+  QFile m_file;
+  QFile m_index_file;
+  uchar *m_data;
+  qint64 m_capacity;
+  qint64 m_offset;
+};
+
+/* --------------------------- PreviewRecordingReader ----------------------- */
+
+class LIB_SPECTER_API PreviewRecordingReader {
+  static const quint32 max_dimension;
+
+public:
+  explicit PreviewRecordingReader(const QString &path);
+  ~PreviewRecordingReader();
+
+  [[nodiscard]] bool open();
+
+  [[nodiscard]] std::optional<PreviewRecorded> readFrame(qint64 timestamp);
+
+  [[nodiscard]] QString getErrorString() const;
+
+private:
+  [[nodiscard]] bool readRecord(
+    const PreviewRecordingFormat::RecordHeader &header, qint64 offset,
+    PreviewRecorded &recorded);
+
+  template<typename T>
+  [[nodiscard]] std::optional<T> read(qint64 offset);
+
+private:
+  QFile m_file;
+  QFile m_index_file;
+  QString m_error;
+  QList<PreviewRecordingFormat::IndexEntry> m_index;
+};
+
+/* ------------------------------ PreviewRecording -------------------------- */
+
+class LIB_SPECTER_API PreviewRecording {
+public:
+  [[nodiscard]] static QString getDirectory();
+  static void setDirectory(const QString &directory);
+
+  [[nodiscard]] static QString getRecordingPath(const QString &id);
+
+public:
+  explicit PreviewRecording(const QString &path);
+  ~PreviewRecording();
+
+  [[nodiscard]] bool
+  start(QObject *object, const PreviewFormat &format, uint max_fps);
+  void stop();
+
+  [[nodiscard]] QString getPath() const;
+  [[nodiscard]] QString getErrorString() const;
+
+private:
+  void writePending();
+
+private:
+  QString m_path;
+  QString m_error;
+  QElapsedTimer m_timer;
+  std::unique_ptr<PreviewRecordingWriter> m_writer;
+  std::shared_ptr<PreviewObserver> m_observer;
+  std::unique_ptr<PreviewObserverQueue> m_observer_queue;
+};
+
+}// namespace specter
+
+#endif// SPECTER_OBSERVE_PREVIEW_RECORDING_H
@@ -0,0 +1,77 @@
+#ifndef SPECTER_OBSERVE_PREVIEW_RING_H
+#define SPECTER_OBSERVE_PREVIEW_RING_H
+
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QSharedMemory>
+#include <QString>
+/* ---------------------------------- Standard ------------------------------ */
+#include <optional>
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/export.h"
+#include "specter/observe/preview/encoder.h"
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* ------------------------------ PreviewRingSlot --------------------------- */
+
+struct LIB_SPECTER_API PreviewRingSlot {
+  quint32 index = 0;
+  quint64 sequence = 0;
+  quint32 size = 0;
+};
+
+/* -------------------------------- PreviewRing ----------------------------- */
+
+class LIB_SPECTER_API PreviewRing {
+  static const quint32 magic;
+  static const quint32 version;
+
+public:
+  static const quint32 default_slot_count;
+  static const quint32 default_slot_size;
+  static const quint32 max_slot_count;
+  static const quint32 max_slot_size;
+
+public:
+  explicit PreviewRing(
+    quint32 slot_count = default_slot_count,
+    quint32 slot_size = default_slot_size);
+  ~PreviewRing();
+
+  [[nodiscard]] bool create();
+
+  [[nodiscard]] QString getKey() const;
+  [[nodiscard]] QString getErrorString() const;
+
+  [[nodiscard]] std::optional<PreviewRingSlot>
+  write(const PreviewFrame &frame);
+
+private:
+  struct Header {
+    quint32 magic;
+    quint32 version;
+    quint32 slot_count;
+    quint32 slot_size;
+  };
+
+  struct SlotHeader {
+    quint64 sequence;
+    quint32 width;
+    quint32 height;
+    quint32 codec;
+    quint32 size;
+  };
+
+  [[nodiscard]] char *slotData(quint32 index);
+
+private:
+  QSharedMemory m_memory;
+  quint32 m_slot_count;
+  quint32 m_slot_size;
+  quint64 m_sequence;
+};
+
+}// namespace specter
+
+#endif// SPECTER_OBSERVE_PREVIEW_RING_H
@@ -30,6 +30,7 @@ public:
     QString property;
     QVariant old_value;
     QVariant new_value;
+    quint32 skipped_updates = 0;
   };
 
 public:
@@ -43,6 +44,9 @@ public:
   [[nodiscard]] const ACTION_SUBTYPE *getIf() const;
 
   [[nodiscard]] std::size_t index() const;
+  [[nodiscard]] QString getProperty() const;
+
+  [[nodiscard]] bool coalesce(const PropertyObservedAction &action);
 
   template<typename TYPE>
   decltype(auto) visit(TYPE &&visitor) const;
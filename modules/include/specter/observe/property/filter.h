@@ -0,0 +1,36 @@
+#ifndef SPECTER_OBSERVE_PROPERTY_FILTER_H
+#define SPECTER_OBSERVE_PROPERTY_FILTER_H
+
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QList>
+#include <QMetaObject>
+#include <QRegularExpression>
+#include <QStringList>
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/export.h"
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* ------------------------------- PropertyFilter --------------------------- */
+
+class LIB_SPECTER_API PropertyFilter {
+public:
+  explicit PropertyFilter(const QStringList &patterns = {});
+  ~PropertyFilter();
+
+  [[nodiscard]] bool isEmpty() const;
+  [[nodiscard]] bool matches(const QString &name) const;
+
+  [[nodiscard]] QList<int>
+  getPropertyIndices(const QMetaObject *meta_object) const;
+
+private:
+  QString m_key;
+  QStringList m_names;
+  QList<QRegularExpression> m_patterns;
+};
+
+}// namespace specter
+
+#endif// SPECTER_OBSERVE_PROPERTY_FILTER_H
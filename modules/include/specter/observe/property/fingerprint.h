@@ -0,0 +1,38 @@
+#ifndef SPECTER_OBSERVE_PROPERTY_FINGERPRINT_H
+#define SPECTER_OBSERVE_PROPERTY_FINGERPRINT_H
+
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QVariant>
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/export.h"
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* ------------------------------ ValueFingerprint -------------------------- */
+
+class LIB_SPECTER_API ValueFingerprint {
+  static const qsizetype min_container_size;
+
+public:
+  [[nodiscard]] static bool isSupported(const QVariant &value);
+
+public:
+  explicit ValueFingerprint(const QVariant &value);
+  ~ValueFingerprint();
+
+  [[nodiscard]] bool matches(const QVariant &value) const;
+
+private:
+  [[nodiscard]] static qint64 generation(const QVariant &value);
+  [[nodiscard]] static size_t hash(const QVariant &value);
+
+private:
+  int m_type;
+  qint64 m_generation;
+  size_t m_hash;
+};
+
+}// namespace specter
+
+#endif// SPECTER_OBSERVE_PROPERTY_FINGERPRINT_H
@@ -3,16 +3,23 @@
 
 /* ------------------------------------ Qt ---------------------------------- */
 #include <QHash>
+#include <QMetaProperty>
 #include <QObject>
 #include <QPointer>
-#include <QQueue>
-#include <QTimer>
 /* ---------------------------------- Standard ------------------------------ */
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
 #include <mutex>
+#include <optional>
 /* ----------------------------------- Local -------------------------------- */
 #include "specter/export.h"
+#include "specter/schedule/scheduler.h"
 #include "specter/observe/property/action.h"
+#include "specter/observe/property/filter.h"
+#include "specter/observe/property/fingerprint.h"
 #include "specter/search/query.h"
 /* -------------------------------------------------------------------------- */
 
@@ -30,6 +37,12 @@ public:
   void setObject(QObject *object);
   QObject *getObject() const;
 
+  void setFilter(const PropertyFilter &filter);
+  [[nodiscard]] const PropertyFilter &getFilter() const;
+
+  void setPollingInterval(std::chrono::milliseconds interval);
+  [[nodiscard]] std::chrono::milliseconds getPollingInterval() const;
+
   void start();
   void stop();
 
@@ -38,19 +51,38 @@ public:
 Q_SIGNALS:
   void actionReported(const PropertyObservedAction &action);
 
+private Q_SLOTS:
+  void onNotifySignal();
+
+private:
+  struct TrackedProperty {
+    QMetaProperty property;
+    QString name;
+    QVariant value;
+    std::optional<ValueFingerprint> fingerprint;
+  };
+
 private:
   void startChangesTracker();
   void stopChangesTracker();
-  void checkForChanges();
+  void checkForPolledChanges();
+  void checkForChange(TrackedProperty &tracked_property);
+  void storeValue(TrackedProperty &tracked_property, const QVariant &value);
+
+  void trackProperties();
+  void untrackProperties();
 
-  [[nodiscard]] std::map<QString, QVariant> getTrackedProperties() const;
   [[nodiscard]] bool variantEqual(const QVariant &a, const QVariant &b) const;
 
 private:
   QPointer<QObject> m_object;
   bool m_observing;
-  QTimer *m_check_timer;
-  std::map<QString, QVariant> m_tracked_properties;
+  Scheduler::TaskId m_check_task;
+  std::chrono::milliseconds m_polling_interval;
+  PropertyFilter m_filter;
+  std::map<int, TrackedProperty> m_tracked_properties;
+  QHash<int, QList<int>> m_notify_signals;
+  QList<int> m_polled_properties;
 };
 
 /* --------------------------- PropertyObserverQueue ---------------------- */
@@ -61,15 +93,28 @@ public:
   ~PropertyObserverQueue();
 
   void setObserver(PropertyObserver *observer);
+  void setNotifier(std::function<void()> notifier);
+  void setMaxRate(uint max_rate);
 
   [[nodiscard]] bool isEmpty() const;
+  [[nodiscard]] bool isReady() const;
+  [[nodiscard]] std::chrono::milliseconds getDelay() const;
+
   [[nodiscard]] PropertyObservedAction popAction();
   [[nodiscard]] PropertyObservedAction waitPopAction();
 
+private:
+  void pushAction(const PropertyObservedAction &action);
+  [[nodiscard]] PropertyObservedAction takeAction();
+
 private:
   PropertyObserver *m_observer;
   QMetaObject::Connection m_on_action_reported;
-  QQueue<PropertyObservedAction> m_observed_actions;
+  std::deque<PropertyObservedAction> m_observed_actions;
+  QHash<QString, quint64> m_pending_updates;
+  quint64 m_popped_actions;
+  RateLimiter m_rate_limiter;
+  std::function<void()> m_notifier;
 
   mutable std::mutex m_mutex;
   std::condition_variable m_cv;
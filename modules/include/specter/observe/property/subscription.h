@@ -0,0 +1,120 @@
+#ifndef SPECTER_OBSERVE_PROPERTY_SUBSCRIPTION_H
+#define SPECTER_OBSERVE_PROPERTY_SUBSCRIPTION_H
+
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+/* ---------------------------------- Standard ------------------------------ */
+#include <deque>
+#include <map>
+#include <memory>
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/export.h"
+#include "specter/observe/property/action.h"
+#include "specter/schedule/scheduler.h"
+#include "specter/search/id.h"
+#include "specter/search/query.h"
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+class PropertyObserver;
+
+/* ---------------------------- PropertyObserverPool ------------------------ */
+
+class LIB_SPECTER_API PropertyObserverPool {
+public:
+  [[nodiscard]] static std::shared_ptr<PropertyObserver>
+  acquire(QObject *object);
+
+private:
+  [[nodiscard]] static std::map<QObject *, std::weak_ptr<PropertyObserver>> &
+  getObservers();
+};
+
+/* ---------------------------- PropertySubscription ------------------------ */
+
+class LIB_SPECTER_API PropertySubscription : public QObject {
+  Q_OBJECT
+
+  static const int query_resolve_interval_ms;
+
+public:
+  struct ObjectChange {
+    ObjectId object_id;
+    PropertyObservedAction action;
+  };
+
+public:
+  [[nodiscard]] static PropertySubscription *find(const QString &id);
+
+public:
+  explicit PropertySubscription();
+  ~PropertySubscription() override;
+
+  [[nodiscard]] QString getId() const;
+
+  void addObject(QObject *object);
+  void removeObject(const ObjectId &object_id);
+
+  void addQuery(const ObjectQuery &query);
+  void removeQuery(const ObjectQuery &query);
+
+  void setMaxRate(uint max_rate);
+
+  [[nodiscard]] bool hasChanges() const;
+  [[nodiscard]] bool isReady() const;
+  [[nodiscard]] std::chrono::milliseconds getDelay() const;
+
+  [[nodiscard]] QList<ObjectChange> takeChanges();
+
+Q_SIGNALS:
+  void changesReported();
+
+private:
+  struct Subscriber {
+    ObjectId object_id = ObjectId{};
+    QPointer<QObject> object_ptr = nullptr;
+    std::shared_ptr<PropertyObserver> observer = nullptr;
+    QMetaObject::Connection on_action_reported = {};
+    QMetaObject::Connection on_destroyed = {};
+    bool explicit_object = false;
+    QSet<QString> queries = {};
+  };
+
+  struct QueryMatch {
+    QPointer<QObject> object_ptr = nullptr;
+    QSet<QString> queries = {};
+  };
+
+private:
+  Subscriber &subscribe(QObject *object);
+  void unsubscribe(QObject *object);
+  void unsubscribeUnused();
+
+  void resolveQueries();
+  void restartQueryResolution();
+  void finishQueryResolution();
+
+  void reportChange(const ObjectId &object_id, PropertyObservedAction action);
+
+private:
+  QString m_id;
+  Scheduler::TaskId m_resolve_task;
+  std::map<QObject *, Subscriber> m_subscribers;
+  std::map<QString, ObjectQuery> m_queries;
+  std::deque<QPointer<QObject>> m_pending_objects;
+  std::map<QObject *, QueryMatch> m_query_matches;
+  QElapsedTimer m_last_resolution;
+  QList<ObjectChange> m_changes;
+  QHash<QPair<qulonglong, QString>, qsizetype> m_pending_updates;
+  RateLimiter m_rate_limiter;
+};
+
+}// namespace specter
+
+#endif// SPECTER_OBSERVE_PROPERTY_SUBSCRIPTION_H
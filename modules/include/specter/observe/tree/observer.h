@@ -2,17 +2,21 @@
 #define SPECTER_OBSERVE_TREE_OBSERVER_H
 
 /* ------------------------------------ Qt ---------------------------------- */
+#include <QEvent>
+#include <QMetaProperty>
 #include <QObject>
 #include <QPointer>
 #include <QQueue>
-#include <QTimer>
+#include <QSet>
 /* ---------------------------------- Standard ------------------------------ */
 #include <condition_variable>
+#include <deque>
 #include <map>
 #include <mutex>
 #include <queue>
 /* ----------------------------------- Local -------------------------------- */
 #include "specter/export.h"
+#include "specter/schedule/scheduler.h"
 #include "specter/observe/tree/action.h"
 #include "specter/search/id.h"
 #include "specter/search/query.h"
@@ -25,6 +29,8 @@ namespace specter {
 class LIB_SPECTER_API TreeObserver : public QObject {
   Q_OBJECT
 
+  static const int full_scan_interval;
+
 public:
   explicit TreeObserver();
   ~TreeObserver() override;
@@ -37,6 +43,12 @@ public:
 Q_SIGNALS:
   void actionReported(const TreeObservedAction &action);
 
+protected:
+  bool eventFilter(QObject *object, QEvent *event) override;
+
+private Q_SLOTS:
+  void onQueryPropertyChanged();
+
 private:
   void startIntervalCheck();
   void stopIntervalCheck();
@@ -46,8 +58,17 @@ private:
   void checkForDestroyedObjects();
   void checkForRenamedObjects();
   void checkForReparentedObjects();
+  void checkForPolledProperties();
+
+  void trackObject(QObject *object);
+  void untrackObjects();
+
+  void markDirty(QObject *object, bool recursive = false);
+  void markChildrenDirty(QObject *object);
+  void markReparented(QObject *object);
 
-  [[nodiscard]] QList<QObject *> getTrackedObjectsInDFSOrder() const;
+  [[nodiscard]] bool isTracked(QObject *object) const;
+  [[nodiscard]] int getTrackedDepth(QObject *object) const;
 
 private:
   struct TrackedObjectCache {
@@ -55,12 +76,21 @@ private:
     ObjectQuery object_query = ObjectQuery{};
     QPointer<QObject> object_ptr = nullptr;
     QObject *parent = nullptr;
+    QList<QMetaProperty> polled_properties = {};
+    QVariantList polled_values = {};
   };
 
 private:
   bool m_observing;
-  QTimer *m_check_timer;
+  Scheduler::TaskId m_check_task;
   std::map<QObject *, TrackedObjectCache> m_tracked_objects;
+  QSet<QObject *> m_dirty_objects;
+  QSet<QObject *> m_polled_objects;
+  QSet<QObject *> m_destroyed_objects;
+  QSet<QObject *> m_reparented_objects;
+  std::deque<QPointer<QObject>> m_scan_queue;
+  bool m_full_scan;
+  int m_ticks_since_full_scan;
 };
 
 /* ----------------------------- TreeObserverQueue ------------------------ */
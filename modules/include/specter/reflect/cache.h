@@ -0,0 +1,81 @@
+#ifndef SPECTER_REFLECT_CACHE_H
+#define SPECTER_REFLECT_CACHE_H
+
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMetaMethod>
+#include <QMetaObject>
+#include <QMetaProperty>
+#include <QMetaType>
+#include <QVariant>
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/export.h"
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* ----------------------------- PropertyDescriptor ------------------------- */
+
+struct LIB_SPECTER_API PropertyDescriptor {
+  int index;
+  QString name;
+  QMetaType meta_type;
+  bool readable;
+  bool writable;
+  QMetaProperty property;
+};
+
+/* ------------------------------ MethodDescriptor -------------------------- */
+
+struct LIB_SPECTER_API MethodDescriptor {
+  int index;
+  QByteArray name;
+  QList<QByteArray> parameter_names;
+  QList<QMetaType> parameter_types;
+  QVariantList default_values;
+  bool listed;
+  QMetaMethod method;
+};
+
+/* ------------------------------- ClassReflection -------------------------- */
+
+class LIB_SPECTER_API ClassReflection {
+public:
+  explicit ClassReflection(const QMetaObject *meta_object);
+  ~ClassReflection();
+
+  [[nodiscard]] const QMetaObject *getMetaObject() const;
+
+  [[nodiscard]] const QList<PropertyDescriptor> &getProperties() const;
+  [[nodiscard]] const PropertyDescriptor *
+  getProperty(const QByteArray &name) const;
+
+  [[nodiscard]] const QList<MethodDescriptor> &getMethods() const;
+  [[nodiscard]] QList<const MethodDescriptor *>
+  getOverloads(const QByteArray &name, qsizetype arity) const;
+
+private:
+  void collectProperties();
+  void collectMethods();
+
+private:
+  const QMetaObject *m_meta_object;
+  QList<PropertyDescriptor> m_properties;
+  QHash<QByteArray, qsizetype> m_property_positions;
+  QList<MethodDescriptor> m_methods;
+  QHash<QPair<QByteArray, qsizetype>, QList<qsizetype>> m_overloads;
+};
+
+/* ------------------------------- ReflectionCache -------------------------- */
+
+class LIB_SPECTER_API ReflectionCache {
+public:
+  [[nodiscard]] static const ClassReflection &
+  get(const QMetaObject *meta_object);
+};
+
+}// namespace specter
+
+#endif// SPECTER_REFLECT_CACHE_H
@@ -0,0 +1,125 @@
+#ifndef SPECTER_SCHEDULE_SCHEDULER_H
+#define SPECTER_SCHEDULE_SCHEDULER_H
+
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+/* --------------------------------- Standard ------------------------------- */
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/export.h"
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* -------------------------------- TaskPriority ---------------------------- */
+
+enum class TaskPriority { Input, Unary, Stream, Preview };
+
+/* --------------------------------- Scheduler ------------------------------ */
+
+class LIB_SPECTER_API Scheduler : public QObject {
+  Q_OBJECT
+
+  static const int tick_interval_ms;
+  static const int max_coarsening;
+  static const std::chrono::microseconds min_frame_budget;
+
+public:
+  using Task = std::function<void()>;
+  using TaskId = quint64;
+
+public:
+  explicit Scheduler();
+  ~Scheduler() override;
+
+  [[nodiscard]] TaskId addPeriodicTask(
+    TaskPriority priority, std::chrono::milliseconds interval, Task task);
+  void removePeriodicTask(TaskId id);
+
+  void post(TaskPriority priority, Task task);
+
+  void setFrameBudget(std::chrono::microseconds budget);
+  [[nodiscard]] std::chrono::microseconds getFrameBudget() const;
+
+  [[nodiscard]] std::chrono::microseconds getRemainingFrameBudget() const;
+
+  [[nodiscard]] bool isHostBusy() const;
+  [[nodiscard]] quint64 getBudgetOverruns() const;
+
+Q_SIGNALS:
+  void budgetExceeded(qint64 spent_us, qint64 budget_us);
+
+private:
+  void tick();
+  void schedulePeriodicTasks(qint64 now_ms);
+  void runPeriodicTask(TaskId id);
+
+private:
+  struct PeriodicTask {
+    TaskPriority priority;
+    std::chrono::milliseconds interval;
+    Task task;
+    qint64 next_run_ms = 0;
+    int coarsening = 1;
+    bool pending = false;
+  };
+
+private:
+  QTimer *m_tick_timer;
+  QElapsedTimer m_clock;
+  QElapsedTimer m_frame;
+  qint64 m_last_tick_ms;
+  std::chrono::microseconds m_frame_budget;
+  bool m_host_busy;
+  quint64 m_budget_overruns;
+  TaskId m_next_task_id;
+  std::map<TaskId, PeriodicTask> m_periodic_tasks;
+  std::array<std::deque<Task>, 4> m_queues;
+};
+
+/* --------------------------------- TimeSlice ------------------------------ */
+
+class LIB_SPECTER_API TimeSlice {
+  static const int check_interval;
+
+public:
+  explicit TimeSlice(std::chrono::microseconds duration);
+  ~TimeSlice();
+
+  [[nodiscard]] bool expired();
+
+private:
+  QElapsedTimer m_timer;
+  qint64 m_duration_ns;
+  int m_steps;
+};
+
+/* -------------------------------- RateLimiter ----------------------------- */
+
+class LIB_SPECTER_API RateLimiter {
+public:
+  explicit RateLimiter(uint max_rate = 0);
+  ~RateLimiter();
+
+  void setMaxRate(uint max_rate);
+  [[nodiscard]] uint getMaxRate() const;
+
+  [[nodiscard]] bool isReady() const;
+  [[nodiscard]] std::chrono::milliseconds getDelay() const;
+
+  void consume();
+
+private:
+  uint m_max_rate;
+  QElapsedTimer m_last_consumed;
+};
+
+}// namespace specter
+
+#endif// SPECTER_SCHEDULE_SCHEDULER_H
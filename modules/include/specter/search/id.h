@@ -23,6 +23,7 @@ public:
   ~ObjectId();
 
   [[nodiscard]] QString toString() const;
+  [[nodiscard]] qulonglong toNumber() const;
 
   [[nodiscard]] bool operator==(const ObjectId &other) const;
   [[nodiscard]] bool operator!=(const ObjectId &other) const;
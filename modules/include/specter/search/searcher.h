@@ -30,6 +30,7 @@ public:
   [[nodiscard]] QObject *getObject(const ObjectQuery &query) const;
   [[nodiscard]] QObject *getObject(const ObjectId &id) const;
   [[nodiscard]] QList<QObject *> getObjects(const ObjectQuery &query) const;
+  [[nodiscard]] QList<QObject *> getObjects(const QList<ObjectId> &ids) const;
 
   [[nodiscard]] ObjectQuery getQuery(const QObject *object) const;
   [[nodiscard]] ObjectQuery getQueryUsingKinds(
@@ -40,6 +41,12 @@ public:
 
   [[nodiscard]] ObjectId getId(const QObject *object) const;
 
+  [[nodiscard]] bool
+  matchesQuery(const QObject *object, const ObjectQuery &query) const;
+
+  [[nodiscard]] QSet<QString>
+  getQueryDependentProperties(const QObject *object) const;
+
   void addStrategy(std::unique_ptr<SearchStrategy> &&strategy);
 
 private:
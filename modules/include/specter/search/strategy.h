@@ -27,6 +27,9 @@ public:
   [[nodiscard]] virtual QVariantMap
   createObjectQuery(const QObject *object) const = 0;
 
+  [[nodiscard]] virtual QSet<QString>
+  queryDependentProperties(const QObject *object) const;
+
 private:
   Kind m_kind;
 };
@@ -62,6 +65,9 @@ public:
   [[nodiscard]] QVariantMap
   createObjectQuery(const QObject *object) const override;
 
+  [[nodiscard]] QSet<QString>
+  queryDependentProperties(const QObject *object) const override;
+
 private:
   [[nodiscard]] static QSet<QString> getUsedProperties(const QObject *object);
   [[nodiscard]] static QMap<int, QSet<QString>> getTypeToProperties();
@@ -5,11 +5,15 @@
 #include <grpc++/alarm.h>
 #include <grpc++/grpc++.h>
 /* --------------------------------- Standard ------------------------------- */
+#include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <variant>
 /* ----------------------------------- Local -------------------------------- */
 #include "specter/export.h"
+#include "specter/module.h"
+#include "specter/schedule/scheduler.h"
 /* -------------------------------------------------------------------------- */
 
 namespace specter {
@@ -24,10 +28,15 @@ struct LIB_SPECTER_API CallTag {
 
 class LIB_SPECTER_API Callable {
 public:
-  explicit Callable();
+  explicit Callable(TaskPriority priority = TaskPriority::Unary);
   virtual ~Callable();
 
   virtual void proceed(bool ok) = 0;
+
+  [[nodiscard]] TaskPriority getPriority() const;
+
+private:
+  TaskPriority m_priority;
 };
 
 /* ---------------------------------- CallData ------------------------------ */
@@ -50,7 +59,8 @@ protected:
 public:
   explicit CallData(
     Service *service, grpc::ServerCompletionQueue *queue, CallTag tag,
-    RequestMethod request_method);
+    RequestMethod request_method,
+    TaskPriority priority = TaskPriority::Unary);
   ~CallData() override;
 
   void proceed(bool ok = true) override;
@@ -78,8 +88,8 @@ protected:
 template<typename SERVICE, typename REQUEST, typename RESPONSE>
 CallData<SERVICE, REQUEST, RESPONSE>::CallData(
   Service *service, grpc::ServerCompletionQueue *queue, CallTag tag,
-  RequestMethod request_method)
-    : m_service(service), m_queue(queue), m_tag(tag),
+  RequestMethod request_method, TaskPriority priority)
+    : Callable(priority), m_service(service), m_queue(queue), m_tag(tag),
       m_request_method(request_method), m_status(CallStatus::Create),
       m_responder(&m_context) {}
 
@@ -130,6 +140,258 @@ CallData<SERVICE, REQUEST, RESPONSE>::getQueue() const {
   return m_queue;
 }
 
+/* ------------------------------- AsyncCallData ---------------------------- */
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+class AsyncCallData : public Callable {
+protected:
+  enum class CallStatus { Create, Process, Processing, Finish };
+
+  using Request = REQUEST;
+  using Response = RESPONSE;
+  using Service = SERVICE;
+
+  using ProcessResult = std::pair<grpc::Status, Response>;
+  using Finisher = std::function<void(ProcessResult)>;
+  using RequestMethod = void (Service::*)(
+    grpc::ServerContext *, Request *,
+    grpc::ServerAsyncResponseWriter<Response> *, grpc::CompletionQueue *,
+    grpc::ServerCompletionQueue *, void *);
+
+public:
+  explicit AsyncCallData(
+    Service *service, grpc::ServerCompletionQueue *queue, CallTag tag,
+    RequestMethod request_method,
+    TaskPriority priority = TaskPriority::Unary);
+  ~AsyncCallData() override;
+
+  void proceed(bool ok = true) override;
+
+  [[nodiscard]] Service *getService() const;
+  [[nodiscard]] grpc::ServerCompletionQueue *getQueue() const;
+
+protected:
+  virtual void process(const Request &request, Finisher finish) const = 0;
+
+  virtual std::unique_ptr<AsyncCallData> clone() const = 0;
+
+private:
+  void finish(ProcessResult result);
+
+protected:
+  Service *m_service;
+  grpc::ServerCompletionQueue *m_queue;
+
+  CallTag m_tag;
+  RequestMethod m_request_method;
+  CallStatus m_status;
+  grpc::ServerContext m_context;
+  Request m_request;
+  grpc::ServerAsyncResponseWriter<Response> m_responder;
+};
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+AsyncCallData<SERVICE, REQUEST, RESPONSE>::AsyncCallData(
+  Service *service, grpc::ServerCompletionQueue *queue, CallTag tag,
+  RequestMethod request_method, TaskPriority priority)
+    : Callable(priority), m_service(service), m_queue(queue), m_tag(tag),
+      m_request_method(request_method), m_status(CallStatus::Create),
+      m_responder(&m_context) {}
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+AsyncCallData<SERVICE, REQUEST, RESPONSE>::~AsyncCallData() = default;
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+void AsyncCallData<SERVICE, REQUEST, RESPONSE>::proceed(bool ok) {
+  if (!ok || m_status == CallStatus::Finish) {
+    delete this;
+    return;
+  }
+
+  switch (m_status) {
+    case CallStatus::Create: {
+      m_status = CallStatus::Process;
+      (m_service->*m_request_method)(
+        &m_context, &m_request, &m_responder, m_queue, m_queue,
+        static_cast<void *>(&m_tag));
+      break;
+    }
+    case CallStatus::Process: {
+      auto cell_data = clone().release();
+      cell_data->proceed();
+
+      m_status = CallStatus::Processing;
+      process(m_request, [this](ProcessResult result) {
+        QMetaObject::invokeMethod(
+          &scheduler(),
+          [this, result = std::move(result)]() {
+            scheduler().post(
+              getPriority(), [this, result]() { finish(result); });
+          },
+          Qt::QueuedConnection);
+      });
+      break;
+    }
+    case CallStatus::Processing:
+      break;
+  }
+}
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+AsyncCallData<SERVICE, REQUEST, RESPONSE>::Service *
+AsyncCallData<SERVICE, REQUEST, RESPONSE>::getService() const {
+  return m_service;
+}
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+grpc::ServerCompletionQueue *
+AsyncCallData<SERVICE, REQUEST, RESPONSE>::getQueue() const {
+  return m_queue;
+}
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+void AsyncCallData<SERVICE, REQUEST, RESPONSE>::finish(ProcessResult result) {
+  const auto &[status, response] = result;
+  if (status.ok()) {
+    m_responder.Finish(response, status, static_cast<void *>(&m_tag));
+  } else {
+    m_responder.FinishWithError(status, static_cast<void *>(&m_tag));
+  }
+
+  m_status = CallStatus::Finish;
+}
+
+/* ------------------------------- SlicedCallData --------------------------- */
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+class SlicedCallData : public Callable {
+protected:
+  enum class CallStatus { Create, Process, Processing, Finish };
+
+  using Request = REQUEST;
+  using Response = RESPONSE;
+  using Service = SERVICE;
+
+  using ProcessResult = std::optional<std::pair<grpc::Status, Response>>;
+  using RequestMethod = void (Service::*)(
+    grpc::ServerContext *, Request *,
+    grpc::ServerAsyncResponseWriter<Response> *, grpc::CompletionQueue *,
+    grpc::ServerCompletionQueue *, void *);
+
+public:
+  explicit SlicedCallData(
+    Service *service, grpc::ServerCompletionQueue *queue, CallTag tag,
+    RequestMethod request_method,
+    TaskPriority priority = TaskPriority::Unary);
+  ~SlicedCallData() override;
+
+  void proceed(bool ok = true) override;
+
+  [[nodiscard]] Service *getService() const;
+  [[nodiscard]] grpc::ServerCompletionQueue *getQueue() const;
+
+protected:
+  [[nodiscard]] virtual ProcessResult process(const Request &request) const = 0;
+
+  virtual std::unique_ptr<SlicedCallData> clone() const = 0;
+
+private:
+  void scheduleNextSlice();
+
+protected:
+  Service *m_service;
+  grpc::ServerCompletionQueue *m_queue;
+
+  CallTag m_tag;
+  RequestMethod m_request_method;
+  CallStatus m_status;
+  grpc::ServerContext m_context;
+  Request m_request;
+  grpc::ServerAsyncResponseWriter<Response> m_responder;
+};
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+SlicedCallData<SERVICE, REQUEST, RESPONSE>::SlicedCallData(
+  Service *service, grpc::ServerCompletionQueue *queue, CallTag tag,
+  RequestMethod request_method, TaskPriority priority)
+    : Callable(priority), m_service(service), m_queue(queue), m_tag(tag),
+      m_request_method(request_method), m_status(CallStatus::Create),
+      m_responder(&m_context) {}
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+SlicedCallData<SERVICE, REQUEST, RESPONSE>::~SlicedCallData() = default;
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+void SlicedCallData<SERVICE, REQUEST, RESPONSE>::proceed(bool ok) {
+  if (!ok || m_status == CallStatus::Finish) {
+    delete this;
+    return;
+  }
+
+  const auto _process = [this]() {
+    const auto result = process(m_request);
+    if (!result.has_value()) {
+      m_status = CallStatus::Processing;
+      scheduleNextSlice();
+      return;
+    }
+
+    const auto &[status, response] = *result;
+    if (status.ok()) {
+      m_responder.Finish(response, status, static_cast<void *>(&m_tag));
+    } else {
+      m_responder.FinishWithError(status, static_cast<void *>(&m_tag));
+    }
+
+    m_status = CallStatus::Finish;
+  };
+
+  switch (m_status) {
+    case CallStatus::Create: {
+      m_status = CallStatus::Process;
+      (m_service->*m_request_method)(
+        &m_context, &m_request, &m_responder, m_queue, m_queue,
+        static_cast<void *>(&m_tag));
+      break;
+    }
+    case CallStatus::Process: {
+      auto cell_data = clone().release();
+      cell_data->proceed();
+
+      _process();
+      break;
+    }
+    case CallStatus::Processing: {
+      if (m_context.IsCancelled()) {
+        m_responder.FinishWithError(
+          grpc::Status::CANCELLED, static_cast<void *>(&m_tag));
+        m_status = CallStatus::Finish;
+        break;
+      }
+
+      _process();
+      break;
+    }
+  }
+}
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+SlicedCallData<SERVICE, REQUEST, RESPONSE>::Service *
+SlicedCallData<SERVICE, REQUEST, RESPONSE>::getService() const {
+  return m_service;
+}
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+grpc::ServerCompletionQueue *
+SlicedCallData<SERVICE, REQUEST, RESPONSE>::getQueue() const {
+  return m_queue;
+}
+
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+void SlicedCallData<SERVICE, REQUEST, RESPONSE>::scheduleNextSlice() {
+  scheduler().post(getPriority(), [this]() { proceed(); });
+}
+
 /* ------------------------------- StreamCallData --------------------------- */
 
 template<typename SERVICE, typename REQUEST, typename RESPONSE>
@@ -150,10 +412,12 @@ protected:
 public:
   explicit StreamCallData(
     Service *service, grpc::ServerCompletionQueue *queue, CallTag tag,
-    RequestMethod request_method);
+    RequestMethod request_method,
+    TaskPriority priority = TaskPriority::Stream);
   ~StreamCallData() override;
 
   void proceed(bool ok = true) override;
+  void wake();
 
   [[nodiscard]] Service *getService() const;
   [[nodiscard]] grpc::ServerCompletionQueue *getQueue() const;
@@ -161,6 +425,7 @@ public:
 protected:
   [[nodiscard]] virtual StartResult start(const Request &request) const = 0;
   [[nodiscard]] virtual ProcessResult process() const = 0;
+  [[nodiscard]] virtual std::chrono::milliseconds getCheckDelay() const;
 
   virtual std::unique_ptr<StreamCallData> clone() const = 0;
 
@@ -178,21 +443,26 @@ protected:
   Request m_request;
   grpc::ServerAsyncWriter<Response> m_responder;
   grpc::Alarm m_alarm;
+  bool m_idle;
+  bool m_woken;
 };
 
 template<typename SERVICE, typename REQUEST, typename RESPONSE>
 StreamCallData<SERVICE, REQUEST, RESPONSE>::StreamCallData(
   Service *service, grpc::ServerCompletionQueue *queue, CallTag tag,
-  RequestMethod request_method)
-    : m_service(service), m_queue(queue), m_tag(tag),
+  RequestMethod request_method, TaskPriority priority)
+    : Callable(priority), m_service(service), m_queue(queue), m_tag(tag),
       m_request_method(request_method), m_status(CallStatus::Create),
-      m_responder(&m_context) {}
+      m_responder(&m_context), m_idle(false), m_woken(false) {}
 
 template<typename SERVICE, typename REQUEST, typename RESPONSE>
 StreamCallData<SERVICE, REQUEST, RESPONSE>::~StreamCallData() = default;
 
 template<typename SERVICE, typename REQUEST, typename RESPONSE>
 void StreamCallData<SERVICE, REQUEST, RESPONSE>::proceed(bool ok) {
+  m_idle = false;
+  if (std::exchange(m_woken, false) && !m_context.IsCancelled()) ok = true;
+
   if (!ok || m_status == CallStatus::Finish) {
     delete this;
     return;
@@ -250,6 +520,14 @@ void StreamCallData<SERVICE, REQUEST, RESPONSE>::proceed(bool ok) {
   }
 }
 
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+void StreamCallData<SERVICE, REQUEST, RESPONSE>::wake() {
+  if (!m_idle || m_woken) return;
+
+  m_woken = true;
+  m_alarm.Cancel();
+}
+
 template<typename SERVICE, typename REQUEST, typename RESPONSE>
 StreamCallData<SERVICE, REQUEST, RESPONSE>::Service *
 StreamCallData<SERVICE, REQUEST, RESPONSE>::getService() const {
@@ -262,11 +540,17 @@ StreamCallData<SERVICE, REQUEST, RESPONSE>::getQueue() const {
   return m_queue;
 }
 
+template<typename SERVICE, typename REQUEST, typename RESPONSE>
+std::chrono::milliseconds
+StreamCallData<SERVICE, REQUEST, RESPONSE>::getCheckDelay() const {
+  return std::chrono::milliseconds(100);
+}
+
 template<typename SERVICE, typename REQUEST, typename RESPONSE>
 void StreamCallData<SERVICE, REQUEST, RESPONSE>::scheduleNextCheck() {
-  auto deadline =
-    std::chrono::system_clock::now() + std::chrono::milliseconds(100);
+  auto deadline = std::chrono::system_clock::now() + getCheckDelay();
   m_alarm.Set(m_queue, deadline, static_cast<void *>(&m_tag));
+  m_idle = true;
 }
 
 }// namespace specter
@@ -4,11 +4,11 @@
 /* ------------------------------------ Qt ---------------------------------- */
 #include <QHostAddress>
 #include <QObject>
-#include <QTimer>
 /* --------------------------------- Standard ------------------------------- */
 #include <memory>
 /* ----------------------------------- Local -------------------------------- */
 #include "specter/export.h"
+#include "specter/schedule/scheduler.h"
 /* -------------------------------------------------------------------------- */
 
 namespace grpc {
@@ -39,7 +39,7 @@ class LIB_SPECTER_API Server : public QObject {
   static const int poll_interval_ms;
 
 public:
-  explicit Server();
+  explicit Server(Scheduler &scheduler);
   ~Server();
 
   void listen(const QHostAddress &host, quint16 port);
@@ -49,7 +49,10 @@ public:
 
 private:
   void startLoop();
+  void poll();
 
+  Scheduler &m_scheduler;
+  Scheduler::TaskId m_poll_task;
   std::list<std::unique_ptr<Service>> m_services;
   std::unique_ptr<grpc::Server> m_server;
   std::unique_ptr<grpc::ServerCompletionQueue> m_queue;
@@ -24,10 +24,13 @@ class PropertyObserver;
 class PropertyObserverQueue;
 class PropertyObservedActionsMapper;
 
+class PropertySubscription;
+class PropertyFilter;
+
 /* ------------------------------- ObjectGetTreeCall ------------------------ */
 
-using ObjectGetTreeCallData = CallData<
-  specter_proto::ObjectService::AsyncService, specter_proto::OptionalObjectId,
+using ObjectGetTreeCallData = SlicedCallData<
+  specter_proto::ObjectService::AsyncService, specter_proto::TreeRequest,
   specter_proto::ObjectTree>;
 
 class LIB_SPECTER_API ObjectGetTreeCall : public ObjectGetTreeCallData {
@@ -42,12 +45,21 @@ public:
   std::unique_ptr<ObjectGetTreeCallData> clone() const override;
 
 private:
-  [[nodiscard]] Response tree(const QObjectList &objects) const;
+  [[nodiscard]] grpc::Status start(const Request &request) const;
+  [[nodiscard]] bool walk(const Request &request) const;
+  [[nodiscard]] bool flatWalk(const Request &request) const;
+  void describe(
+    const QObject *object, specter_proto::ObjectNode *node,
+    const specter_proto::ObjectNodeFields &fields) const;
+
+private:
+  struct TreeWalk;
+  std::unique_ptr<TreeWalk> m_walk;
 };
 
 /* -------------------------------- ObjectFindCall -------------------------- */
 
-using ObjectFindCallData = CallData<
+using ObjectFindCallData = SlicedCallData<
   specter_proto::ObjectService::AsyncService, specter_proto::ObjectSearchQuery,
   specter_proto::ObjectIds>;
 
@@ -63,7 +75,8 @@ public:
   std::unique_ptr<ObjectFindCallData> clone() const override;
 
 private:
-  [[nodiscard]] Response find(const QObjectList &objects) const;
+  struct FindWalk;
+  std::unique_ptr<FindWalk> m_walk;
 };
 
 /* ------------------------- ObjectGetObjectQueryCallData ------------------- */
@@ -146,15 +159,6 @@ public:
   ProcessResult process(const Request &request) const override;
 
   std::unique_ptr<ObjectCallMethodCallData> clone() const override;
-
-private:
-  [[nodiscard]] ProcessResult invoke(
-    QObject *object, const std::string &method,
-    const google::protobuf::RepeatedPtrField<google::protobuf::Value>
-      &arguments) const;
-  [[nodiscard]] QMetaMethod metaMethod(
-    const QObject *object, const std::string &name,
-    const QVariantList &parameters) const;
 };
 
 /* -------------------------- ObjectUpdatePropertyCall -------------------- */
@@ -174,11 +178,44 @@ public:
   ProcessResult process(const Request &request) const override;
 
   std::unique_ptr<ObjectUpdatePropertyCallData> clone() const override;
+};
 
-private:
-  [[nodiscard]] ProcessResult setProperty(
-    QObject *object, const std::string &property,
-    const google::protobuf::Value &value) const;
+/* ------------------------- ObjectUpdatePropertiesCall ------------------- */
+
+using ObjectUpdatePropertiesCallData = CallData<
+  specter_proto::ObjectService::AsyncService, specter_proto::PropertyUpdates,
+  specter_proto::ObjectStatuses>;
+
+class LIB_SPECTER_API ObjectUpdatePropertiesCall
+    : public ObjectUpdatePropertiesCallData {
+public:
+  explicit ObjectUpdatePropertiesCall(
+    specter_proto::ObjectService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~ObjectUpdatePropertiesCall() override;
+
+  ProcessResult process(const Request &request) const override;
+
+  std::unique_ptr<ObjectUpdatePropertiesCallData> clone() const override;
+};
+
+/* --------------------------- ObjectApplyToQueryCall --------------------- */
+
+using ObjectApplyToQueryCallData = CallData<
+  specter_proto::ObjectService::AsyncService, specter_proto::QueryApplication,
+  specter_proto::ObjectStatuses>;
+
+class LIB_SPECTER_API ObjectApplyToQueryCall
+    : public ObjectApplyToQueryCallData {
+public:
+  explicit ObjectApplyToQueryCall(
+    specter_proto::ObjectService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~ObjectApplyToQueryCall() override;
+
+  ProcessResult process(const Request &request) const override;
+
+  std::unique_ptr<ObjectApplyToQueryCallData> clone() const override;
 };
 
 /* ---------------------------- ObjectGetMethodsCall ---------------------- */
@@ -205,8 +242,8 @@ private:
 /* --------------------------- ObjectGetPropertiesCall -------------------- */
 
 using ObjectGetPropertiesCallData = CallData<
-  specter_proto::ObjectService::AsyncService, specter_proto::ObjectId,
-  specter_proto::Properties>;
+  specter_proto::ObjectService::AsyncService,
+  specter_proto::PropertiesRequest, specter_proto::Properties>;
 
 class LIB_SPECTER_API ObjectGetPropertiesCall
     : public ObjectGetPropertiesCallData {
@@ -221,7 +258,33 @@ public:
   std::unique_ptr<ObjectGetPropertiesCallData> clone() const override;
 
 private:
-  [[nodiscard]] Response properties(const QObject *object) const;
+  [[nodiscard]] Response properties(
+    const QObject *object, const PropertyFilter &filter,
+    specter_proto::ValueEncoding encoding) const;
+};
+
+/* ------------------------- ObjectGetPropertiesBulkCall ------------------ */
+
+using ObjectGetPropertiesBulkCallData = StreamCallData<
+  specter_proto::ObjectService::AsyncService,
+  specter_proto::PropertiesBulkRequest, specter_proto::PropertiesBulk>;
+
+class LIB_SPECTER_API ObjectGetPropertiesBulkCall
+    : public ObjectGetPropertiesBulkCallData {
+public:
+  explicit ObjectGetPropertiesBulkCall(
+    specter_proto::ObjectService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~ObjectGetPropertiesBulkCall() override;
+
+  StartResult start(const Request &request) const override;
+  ProcessResult process() const override;
+
+  std::unique_ptr<ObjectGetPropertiesBulkCallData> clone() const override;
+
+private:
+  struct BulkRead;
+  std::unique_ptr<BulkRead> m_read;
 };
 
 /* ------------------------- ObjectListenTreeChangesCall ------------------ */
@@ -252,8 +315,8 @@ private:
 /* ----------------------- ObjectListenPropertyChangesCall ---------------- */
 
 using ObjectListenPropertyChangesCallData = StreamCallData<
-  specter_proto::ObjectService::AsyncService, specter_proto::ObjectId,
-  specter_proto::PropertyChange>;
+  specter_proto::ObjectService::AsyncService,
+  specter_proto::PropertiesRequest, specter_proto::PropertyChange>;
 
 class LIB_SPECTER_API ObjectListenPropertyChangesCall
     : public ObjectListenPropertyChangesCallData {
@@ -265,6 +328,7 @@ public:
 
   StartResult start(const Request &request) const override;
   ProcessResult process() const override;
+  std::chrono::milliseconds getCheckDelay() const override;
 
   std::unique_ptr<ObjectListenPropertyChangesCallData> clone() const override;
 
@@ -274,6 +338,52 @@ private:
   std::unique_ptr<PropertyObservedActionsMapper> m_mapper;
 };
 
+/* ------------------------ ObjectSubscribePropertiesCall ----------------- */
+
+using ObjectSubscribePropertiesCallData = StreamCallData<
+  specter_proto::ObjectService::AsyncService,
+  specter_proto::PropertySubscription, specter_proto::PropertyChanges>;
+
+class LIB_SPECTER_API ObjectSubscribePropertiesCall
+    : public ObjectSubscribePropertiesCallData {
+public:
+  explicit ObjectSubscribePropertiesCall(
+    specter_proto::ObjectService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~ObjectSubscribePropertiesCall() override;
+
+  StartResult start(const Request &request) const override;
+  ProcessResult process() const override;
+  std::chrono::milliseconds getCheckDelay() const override;
+
+  std::unique_ptr<ObjectSubscribePropertiesCallData> clone() const override;
+
+private:
+  std::unique_ptr<PropertySubscription> m_subscription;
+  std::unique_ptr<PropertyObservedActionsMapper> m_mapper;
+  mutable bool m_announced;
+};
+
+/* --------------------- ObjectUpdatePropertySubscriptionCall ------------- */
+
+using ObjectUpdatePropertySubscriptionCallData = CallData<
+  specter_proto::ObjectService::AsyncService,
+  specter_proto::PropertySubscriptionUpdate, google::protobuf::Empty>;
+
+class LIB_SPECTER_API ObjectUpdatePropertySubscriptionCall
+    : public ObjectUpdatePropertySubscriptionCallData {
+public:
+  explicit ObjectUpdatePropertySubscriptionCall(
+    specter_proto::ObjectService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~ObjectUpdatePropertySubscriptionCall() override;
+
+  ProcessResult process(const Request &request) const override;
+
+  std::unique_ptr<ObjectUpdatePropertySubscriptionCallData>
+  clone() const override;
+};
+
 /* ------------------------------- ObjectService -------------------------- */
 
 class ObjectService
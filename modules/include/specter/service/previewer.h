@@ -14,12 +14,13 @@ namespace specter {
 
 class PreviewObserver;
 class PreviewObserverQueue;
+class PreviewRing;
 
 /* ------------------------- PreviewerListenCommandsCall -------------------- */
 
 using PreviewerListenCommandsCallData = StreamCallData<
-  specter_proto::PreviewerService::AsyncService, specter_proto::ObjectId,
-  specter_proto::PreviewImage>;
+  specter_proto::PreviewerService::AsyncService,
+  specter_proto::PreviewRequest, specter_proto::PreviewImage>;
 
 class LIB_SPECTER_API PreviewerListenCommandsCall
     : public PreviewerListenCommandsCallData {
@@ -31,12 +32,148 @@ public:
 
   StartResult start(const Request &request) const override;
   ProcessResult process() const override;
+  std::chrono::milliseconds getCheckDelay() const override;
 
   std::unique_ptr<PreviewerListenCommandsCallData> clone() const override;
 
 private:
-  std::unique_ptr<PreviewObserver> m_observer;
+  mutable std::shared_ptr<PreviewObserver> m_observer;
   std::unique_ptr<PreviewObserverQueue> m_observer_queue;
+  mutable std::unique_ptr<PreviewRing> m_ring;
+  mutable bool m_announced;
+};
+
+/* ------------------------- PreviewerForceKeyframeCall --------------------- */
+
+using PreviewerForceKeyframeCallData = CallData<
+  specter_proto::PreviewerService::AsyncService,
+  specter_proto::PreviewStream, google::protobuf::Empty>;
+
+class LIB_SPECTER_API PreviewerForceKeyframeCall
+    : public PreviewerForceKeyframeCallData {
+public:
+  explicit PreviewerForceKeyframeCall(
+    specter_proto::PreviewerService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~PreviewerForceKeyframeCall() override;
+
+  ProcessResult process(const Request &request) const override;
+
+  std::unique_ptr<PreviewerForceKeyframeCallData> clone() const override;
+};
+
+/* --------------------------- PreviewerScreenshotCall ---------------------- */
+
+using PreviewerScreenshotCallData = AsyncCallData<
+  specter_proto::PreviewerService::AsyncService,
+  specter_proto::ScreenshotRequest, specter_proto::Screenshots>;
+
+class LIB_SPECTER_API PreviewerScreenshotCall
+    : public PreviewerScreenshotCallData {
+public:
+  explicit PreviewerScreenshotCall(
+    specter_proto::PreviewerService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~PreviewerScreenshotCall() override;
+
+  void process(const Request &request, Finisher finish) const override;
+
+  std::unique_ptr<PreviewerScreenshotCallData> clone() const override;
+};
+
+/* ------------------------ PreviewerUploadReferenceCall -------------------- */
+
+using PreviewerUploadReferenceCallData = CallData<
+  specter_proto::PreviewerService::AsyncService,
+  specter_proto::ReferenceImage, specter_proto::ReferenceImageId>;
+
+class LIB_SPECTER_API PreviewerUploadReferenceCall
+    : public PreviewerUploadReferenceCallData {
+public:
+  explicit PreviewerUploadReferenceCall(
+    specter_proto::PreviewerService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~PreviewerUploadReferenceCall() override;
+
+  ProcessResult process(const Request &request) const override;
+
+  std::unique_ptr<PreviewerUploadReferenceCallData> clone() const override;
+};
+
+/* -------------------------- PreviewerCompareImageCall --------------------- */
+
+using PreviewerCompareImageCallData = CallData<
+  specter_proto::PreviewerService::AsyncService,
+  specter_proto::ImageComparisonRequest, specter_proto::ImageComparison>;
+
+class LIB_SPECTER_API PreviewerCompareImageCall
+    : public PreviewerCompareImageCallData {
+public:
+  explicit PreviewerCompareImageCall(
+    specter_proto::PreviewerService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~PreviewerCompareImageCall() override;
+
+  ProcessResult process(const Request &request) const override;
+
+  std::unique_ptr<PreviewerCompareImageCallData> clone() const override;
+};
+
+/* ----------------------- PreviewerStartRecordingCall ---------------------- */
+
+using PreviewerStartRecordingCallData = CallData<
+  specter_proto::PreviewerService::AsyncService,
+  specter_proto::RecordingRequest, specter_proto::Recording>;
+
+class LIB_SPECTER_API PreviewerStartRecordingCall
+    : public PreviewerStartRecordingCallData {
+public:
+  explicit PreviewerStartRecordingCall(
+    specter_proto::PreviewerService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~PreviewerStartRecordingCall() override;
+
+  ProcessResult process(const Request &request) const override;
+
+  std::unique_ptr<PreviewerStartRecordingCallData> clone() const override;
+};
+
+/* ----------------------- PreviewerStopRecordingCall ----------------------- */
+
+using PreviewerStopRecordingCallData = CallData<
+  specter_proto::PreviewerService::AsyncService,
+  specter_proto::Recording, google::protobuf::Empty>;
+
+class LIB_SPECTER_API PreviewerStopRecordingCall
+    : public PreviewerStopRecordingCallData {
+public:
+  explicit PreviewerStopRecordingCall(
+    specter_proto::PreviewerService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~PreviewerStopRecordingCall() override;
+
+  ProcessResult process(const Request &request) const override;
+
+  std::unique_ptr<PreviewerStopRecordingCallData> clone() const override;
+};
+
+/* --------------------- PreviewerReadRecordedFrameCall --------------------- */
+
+using PreviewerReadRecordedFrameCallData = AsyncCallData<
+  specter_proto::PreviewerService::AsyncService,
+  specter_proto::RecordedFrameRequest, specter_proto::RecordedFrame>;
+
+class LIB_SPECTER_API PreviewerReadRecordedFrameCall
+    : public PreviewerReadRecordedFrameCallData {
+public:
+  explicit PreviewerReadRecordedFrameCall(
+    specter_proto::PreviewerService::AsyncService *service,
+    grpc::ServerCompletionQueue *queue);
+  ~PreviewerReadRecordedFrameCall() override;
+
+  void process(const Request &request, Finisher finish) const override;
+
+  std::unique_ptr<PreviewerReadRecordedFrameCallData> clone() const override;
 };
 
 /* ------------------------------ PreviewerService -------------------------- */
@@ -19,6 +19,12 @@ namespace specter {
 QVariant convertIntoVariant(const google::protobuf::Value &value);
 google::protobuf::Value convertIntoValue(const QVariant &variant);
 
+QVariant convertIntoVariant(const specter_proto::SpecterValue &value);
+specter_proto::SpecterValue convertIntoSpecterValue(const QVariant &variant);
+
+QStringList convertIntoStringList(
+  const google::protobuf::RepeatedPtrField<std::string> &strings);
+
 std::pair<grpc::Status, QObjectList> tryGetObjects(const ObjectQuery &query);
 
 std::pair<grpc::Status, QObject *> tryGetSingleObject(const ObjectQuery &query);
@@ -1,6 +1,7 @@
 /* ----------------------------------- Local -------------------------------- */
 #include "specter/config.h"
 #include "specter/module.h"
+#include "specter/observe/preview/recording.h"
 /* ------------------------------------ Qt ---------------------------------- */
 #include <QApplication>
 #include <QThread>
@@ -10,22 +11,42 @@
 void startServer() {
   auto valid_port = false;
   auto valid_host = false;
+  auto valid_budget = false;
+
+  const auto default_budget = 4000u;
 
   const auto str_host = qEnvironmentVariable("SPECTER_SERVER_HOST", "0.0.0.0");
   const auto str_port = qEnvironmentVariable("SPECTER_SERVER_PORT", "5010");
+  const auto str_budget = qEnvironmentVariable(
+    "SPECTER_FRAME_BUDGET_US", QString::number(default_budget));
+  const auto recording_dir = qEnvironmentVariable("SPECTER_RECORDING_DIR");
 
   const auto host = QHostAddress(str_host);
   valid_host = !host.isNull();
 
   const auto port = str_port.toUInt(&valid_port);
+  auto budget_us = str_budget.toUInt(&valid_budget);
 
   if (!valid_host) return;
   if (!valid_port) return;
+  if (!valid_budget) {
+    qWarning(
+      "specter: invalid SPECTER_FRAME_BUDGET_US '%s', using %u us",
+      qPrintable(str_budget), default_budget);
+    budget_us = default_budget;
+  }
+
+  const auto budget = std::chrono::microseconds(budget_us);
 
   QMetaObject::invokeMethod(
     qApp,
-    [host, port]() {
+    [host, port, budget, recording_dir]() {
+      if (!recording_dir.isEmpty()) {
+        specter::PreviewRecording::setDirectory(recording_dir);
+      }
+
       auto &specter = specter::SpecterModule::getInstance();
+      specter.getScheduler().setFrameBudget(budget);
       specter.getServer().listen(host, port);
     },
     Qt::QueuedConnection);
@@ -24,7 +24,8 @@ SpecterModule &SpecterModule::getInstance() {
 void SpecterModule::deleteInstance() { m_instance.reset(nullptr); }
 
 SpecterModule::SpecterModule()
-    : m_server(std::make_unique<Server>()),
+    : m_scheduler(std::make_unique<Scheduler>()),
+      m_server(std::make_unique<Server>(*m_scheduler)),
       m_marker(std::make_unique<Marker>()),
       m_searcher(std::make_unique<Searcher>()),
       m_mouse_controller(std::make_unique<MouseController>()),
@@ -44,6 +45,8 @@ SpecterModule::SpecterModule()
 
 SpecterModule::~SpecterModule() = default;
 
+Scheduler &SpecterModule::getScheduler() const { return *m_scheduler; }
+
 Server &SpecterModule::getServer() const { return *m_server; }
 
 Marker &SpecterModule::getMarker() const { return *m_marker; }
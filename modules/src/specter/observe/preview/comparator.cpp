@@ -0,0 +1,223 @@
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/observe/preview/comparator.h"
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QBuffer>
+#include <QCache>
+#include <QCryptographicHash>
+#include <QImageReader>
+/* --------------------------------- Standard ------------------------------- */
+#include <algorithm>
+#include <cstdlib>
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+QCache<QString, QImage> &getReferences() {
+  static auto references = QCache<QString, QImage>{};
+  return references;
+}
+
+inline int channelDiff(quint32 a, quint32 b) {
+  const auto diff = [a, b](int shift) {
+    return std::abs(int((a >> shift) & 0xff) - int((b >> shift) & 0xff));
+  };
+
+  return std::max(std::max(diff(0), diff(8)), std::max(diff(16), diff(24)));
+}
+
+inline int luma(quint32 pixel) {
+  return (qRed(pixel) * 77 + qGreen(pixel) * 150 + qBlue(pixel) * 29) >> 8;
+}
+
+}// namespace
+
+namespace specter {
+
+/* ------------------------------ ImageComparator --------------------------- */
+
+const int ImageComparator::cell_size = 16;
+const int ImageComparator::window_size = 8;
+const qsizetype ImageComparator::max_reference_cost = 256 * 1024 * 1024;
+const qsizetype ImageComparator::max_reference_size = 64 * 1024 * 1024;
+
+std::pair<ReferenceStatus, QString>
+ImageComparator::addReference(const QByteArray &data) {
+  const auto hash = QString::fromLatin1(
+    QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+
+  auto &references = getReferences();
+  references.setMaxCost(max_reference_cost);
+  if (references.contains(hash)) return {ReferenceStatus::Added, hash};
+
+  QBuffer buffer;
+  buffer.setData(data);
+  if (!buffer.open(QIODevice::ReadOnly)) return {ReferenceStatus::Invalid, {}};
+
+  QImageReader reader(&buffer);
+  const auto size = reader.size();
+  const auto declared_cost = qint64(size.width()) * size.height() * 4;
+  if (size.isValid() && declared_cost > max_reference_size) {
+    return {ReferenceStatus::TooLarge, {}};
+  }
+
+  auto image = reader.read();
+  if (image.isNull()) return {ReferenceStatus::Invalid, {}};
+
+  image.convertTo(QImage::Format_ARGB32);
+  const auto cost = image.sizeInBytes();
+  if (cost > max_reference_size) return {ReferenceStatus::TooLarge, {}};
+
+  references.insert(hash, new QImage(std::move(image)), cost);
+  return {ReferenceStatus::Added, hash};
+}
+
+std::optional<QImage> ImageComparator::findReference(const QString &hash) {
+  const auto reference = getReferences().object(hash);
+  return reference ? std::optional<QImage>(*reference) : std::nullopt;
+}
+
+ImageComparator::ImageComparator(int tolerance, bool diff_mask)
+    : m_tolerance(tolerance), m_diff_mask(diff_mask) {}
+
+ImageComparator::~ImageComparator() = default;
+
+ImageComparison ImageComparator::compare(
+  const QImage &actual, const QImage &reference) const {
+  if (actual.size() != reference.size()) {
+    const auto bounds = actual.rect().united(reference.rect());
+    return ImageComparison{
+      false, 0.0, quint64(bounds.width()) * bounds.height(), {bounds}, {}};
+  }
+
+  const auto a = actual.convertToFormat(QImage::Format_ARGB32);
+  const auto b = reference.convertToFormat(QImage::Format_ARGB32);
+  const auto bounds = a.rect();
+
+  const auto columns = (bounds.width() + cell_size - 1) / cell_size;
+  const auto rows = (bounds.height() + cell_size - 1) / cell_size;
+  auto cells = QList<bool>(columns * rows, false);
+
+  auto comparison = ImageComparison{};
+  if (m_diff_mask) {
+    comparison.diff_mask = QImage(bounds.size(), QImage::Format_Grayscale8);
+  }
+
+  for (auto y = 0; y < bounds.height(); ++y) {
+    const auto line_a = reinterpret_cast<const quint32 *>(a.constScanLine(y));
+    const auto line_b = reinterpret_cast<const quint32 *>(b.constScanLine(y));
+    const auto line_mask =
+      m_diff_mask ? comparison.diff_mask.scanLine(y) : nullptr;
+
+    for (auto column = 0; column < columns; ++column) {
+      const auto begin = column * cell_size;
+      const auto end = std::min(begin + cell_size, bounds.width());
+
+      auto mismatched = 0;
+      for (auto x = begin; x < end; ++x) {
+        const auto mismatch = channelDiff(line_a[x], line_b[x]) > m_tolerance;
+        mismatched += mismatch;
+        if (line_mask) line_mask[x] = mismatch ? 0xff : 0x00;
+      }
+
+      comparison.mismatched_pixels += mismatched;
+      if (mismatched > 0) cells[(y / cell_size) * columns + column] = true;
+    }
+  }
+
+  comparison.similarity = similarity(a, b);
+  comparison.mismatches = mismatches(cells, columns, bounds);
+  return comparison;
+}
+
+double ImageComparator::similarity(const QImage &a, const QImage &b) {
+  constexpr auto c1 = (0.01 * 255) * (0.01 * 255);
+  constexpr auto c2 = (0.03 * 255) * (0.03 * 255);
+
+  auto total = 0.0;
+  auto windows = 0;
+
+  for (auto top = 0; top < a.height(); top += window_size) {
+    for (auto left = 0; left < a.width(); left += window_size) {
+      const auto bottom = std::min(top + window_size, a.height());
+      const auto right = std::min(left + window_size, a.width());
+
+      auto sum_a = 0.0, sum_b = 0.0;
+      auto sum_aa = 0.0, sum_bb = 0.0, sum_ab = 0.0;
+      for (auto y = top; y < bottom; ++y) {
+        const auto line_a =
+          reinterpret_cast<const quint32 *>(a.constScanLine(y));
+        const auto line_b =
+          reinterpret_cast<const quint32 *>(b.constScanLine(y));
+
+        for (auto x = left; x < right; ++x) {
+          const auto la = luma(line_a[x]);
+          const auto lb = luma(line_b[x]);
+          sum_a += la;
+          sum_b += lb;
+          sum_aa += la * la;
+          sum_bb += lb * lb;
+          sum_ab += la * lb;
+        }
+      }
+
+      const auto n = double((bottom - top) * (right - left));
+      const auto mean_a = sum_a / n;
+      const auto mean_b = sum_b / n;
+      const auto var_a = sum_aa / n - mean_a * mean_a;
+      const auto var_b = sum_bb / n - mean_b * mean_b;
+      const auto cov = sum_ab / n - mean_a * mean_b;
+
+      const auto luminance =
+        (2 * mean_a * mean_b + c1) / (mean_a * mean_a + mean_b * mean_b + c1);
+      const auto contrast = (2 * cov + c2) / (var_a + var_b + c2);
+
+      total += luminance * contrast;
+      ++windows;
+    }
+  }
+
+  return windows > 0 ? total / windows : 1.0;
+}
+
+QList<QRect> ImageComparator::mismatches(
+  const QList<bool> &cells, int columns, const QRect &bounds) {
+  auto visited = QList<bool>(cells.size(), false);
+  auto rects = QList<QRect>{};
+  auto pending = QList<int>{};
+
+  for (auto start = 0; start < cells.size(); ++start) {
+    if (!cells[start] || visited[start]) continue;
+
+    auto rect = QRect{};
+    visited[start] = true;
+    pending.append(start);
+
+    while (!pending.empty()) {
+      const auto cell = pending.takeLast();
+      const auto column = cell % columns;
+      const auto row = cell / columns;
+      rect |= QRect(column * cell_size, row * cell_size, cell_size, cell_size);
+
+      for (auto dy = -1; dy <= 1; ++dy) {
+        for (auto dx = -1; dx <= 1; ++dx) {
+          const auto x = column + dx;
+          const auto y = row + dy;
+          if (x < 0 || x >= columns || y < 0) continue;
+
+          const auto neighbour = y * columns + x;
+          if (neighbour >= cells.size()) continue;
+          if (!cells[neighbour] || visited[neighbour]) continue;
+
+          visited[neighbour] = true;
+          pending.append(neighbour);
+        }
+      }
+    }
+
+    rects.append(rect.intersected(bounds));
+  }
+
+  return rects;
+}
+
+}// namespace specter
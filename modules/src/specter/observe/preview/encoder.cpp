@@ -0,0 +1,306 @@
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/observe/preview/encoder.h"
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QBuffer>
+#include <QHashFunctions>
+#include <QThread>
+/* --------------------------------- Standard ------------------------------- */
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <utility>
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+QImage scaleImage(const QImage &image, const QSize &max_size) {
+  const auto bound = QSize(
+    max_size.width() > 0 ? max_size.width() : image.width(),
+    max_size.height() > 0 ? max_size.height() : image.height());
+
+  if (image.width() <= bound.width() && image.height() <= bound.height()) {
+    return image;
+  }
+
+  return image.scaled(bound, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+QByteArray saveImage(const QImage &image, const char *format, int quality) {
+  QByteArray imageData;
+  QBuffer buffer(&imageData);
+  if (!buffer.open(QIODevice::WriteOnly)) { return {}; }
+
+  bool success = image.save(&buffer, format, quality);
+  if (!success) { return {}; }
+
+  return imageData;
+}
+
+QByteArray copyPixels(const QImage &image) {
+  return QByteArray(
+    reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes());
+}
+
+size_t hashTile(const QImage &image, const QRect &tile) {
+  const auto row_bytes = qsizetype(tile.width()) * 4;
+
+  auto hash = size_t{0};
+  for (auto y = tile.top(); y <= tile.bottom(); ++y) {
+    hash = qHashBits(image.constScanLine(y) + tile.left() * 4, row_bytes, hash);
+  }
+
+  return hash;
+}
+
+}// namespace
+
+namespace specter {
+
+/* ------------------------------- PreviewEncoder --------------------------- */
+
+struct PreviewEncoder::TileState {
+  QSize size = QSize{};
+  QList<size_t> hashes = {};
+  int frames_since_keyframe = 0;
+};
+
+struct PreviewEncoder::State {
+  std::mutex mutex;
+  Sink sink;
+  PreviewFormat format;
+  std::optional<QImage> pending;
+  bool running = false;
+  bool keyframe_requested = true;
+  quint64 dropped_frames = 0;
+  TileState tile_state;
+};
+
+const int PreviewEncoder::max_thread_count = 4;
+const int PreviewEncoder::fast_png_quality = 80;
+const int PreviewEncoder::min_tile_size = 8;
+
+PreviewFrame PreviewEncoder::encode(QImage image, const PreviewFormat &format) {
+  image = scaleImage(image, format.max_size);
+  return PreviewFrame{encodeData(image, format), image.size(), format.codec};
+}
+
+void PreviewEncoder::encode(
+  QList<QImage> images, const PreviewFormat &format, BatchSink sink) {
+  if (images.empty()) {
+    sink({});
+    return;
+  }
+
+  struct Batch {
+    QList<QImage> images;
+    PreviewFormat format;
+    BatchSink sink;
+    QList<PreviewFrame> frames;
+    std::atomic<qsizetype> remaining;
+  };
+
+  const auto count = images.size();
+  auto batch = std::make_shared<Batch>();
+  batch->images = std::move(images);
+  batch->format = format;
+  batch->sink = std::move(sink);
+  batch->frames.resize(count);
+  batch->remaining = count;
+
+  for (auto i = qsizetype{0}; i < count; ++i) {
+    getThreadPool().start([batch, i]() {
+      const auto &image = std::as_const(batch->images)[i];
+      if (!image.isNull()) batch->frames[i] = encode(image, batch->format);
+
+      if (--batch->remaining == 0) batch->sink(std::move(batch->frames));
+    });
+  }
+}
+
+QImage PreviewEncoder::decode(
+  const QByteArray &data, const QSize &size, PreviewCodec codec) {
+  const auto bits = reinterpret_cast<const uchar *>(data.constData());
+  const auto raw_size = qsizetype(size.width()) * size.height() * 4;
+
+  switch (codec) {
+    case PreviewCodec::Png:
+    case PreviewCodec::FastPng:
+    case PreviewCodec::Jpeg:
+      return QImage::fromData(data);
+
+    case PreviewCodec::RawRgba:
+      if (data.size() < raw_size) return {};
+      return QImage(bits, size.width(), size.height(), QImage::Format_RGBA8888)
+        .copy();
+
+    case PreviewCodec::RawBgra:
+      if (data.size() < raw_size) return {};
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+      return QImage(bits, size.width(), size.height(), QImage::Format_ARGB32)
+        .copy();
+#else
+      return QImage(bits, size.width(), size.height(), QImage::Format_RGBA8888)
+        .rgbSwapped();
+#endif
+  }
+
+  return {};
+}
+
+PreviewEncoder::PreviewEncoder(Sink sink)
+    : m_state(std::make_shared<State>()) {
+  m_state->sink = std::move(sink);
+}
+
+PreviewEncoder::~PreviewEncoder() {
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  m_state->sink = nullptr;
+  m_state->pending.reset();
+}
+
+void PreviewEncoder::setFormat(const PreviewFormat &format) {
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  m_state->format = format;
+  m_state->keyframe_requested = true;
+}
+
+PreviewFormat PreviewEncoder::getFormat() const {
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  return m_state->format;
+}
+
+void PreviewEncoder::encode(QImage image) {
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  if (m_state->pending) ++m_state->dropped_frames;
+  m_state->pending = std::move(image);
+
+  if (m_state->running) return;
+  m_state->running = true;
+
+  getThreadPool().start([state = m_state]() { run(state); });
+}
+
+void PreviewEncoder::requestKeyframe() {
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  m_state->keyframe_requested = true;
+}
+
+quint64 PreviewEncoder::getDroppedFrames() const {
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  return m_state->dropped_frames;
+}
+
+PreviewFrame PreviewEncoder::encodeDelta(
+  QImage image, const PreviewFormat &format, TileState &tile_state,
+  bool keyframe) {
+  image = scaleImage(image, format.max_size);
+  if (image.depth() != 32) image.convertTo(QImage::Format_ARGB32_Premultiplied);
+
+  const auto tile_size = qMax(format.tile_size, min_tile_size);
+  const auto bounds = image.rect();
+
+  auto tiles = QList<QRect>{};
+  auto hashes = QList<size_t>{};
+  for (auto y = 0; y < bounds.height(); y += tile_size) {
+    for (auto x = 0; x < bounds.width(); x += tile_size) {
+      const auto tile = QRect(x, y, tile_size, tile_size).intersected(bounds);
+      tiles.append(tile);
+      hashes.append(hashTile(image, tile));
+    }
+  }
+
+  keyframe = keyframe || tile_state.size != image.size() ||
+             (format.keyframe_interval > 0 &&
+              tile_state.frames_since_keyframe >= format.keyframe_interval);
+
+  auto frame = PreviewFrame{{}, image.size(), format.codec, keyframe, {}};
+  if (keyframe) {
+    frame.data = encodeData(image, format);
+    tile_state.frames_since_keyframe = 0;
+  } else {
+    for (auto i = 0; i < tiles.size(); ++i) {
+      if (hashes[i] == tile_state.hashes[i]) continue;
+      frame.tiles.append(
+        PreviewTile{tiles[i], encodeData(image.copy(tiles[i]), format)});
+    }
+
+    if (!frame.tiles.empty()) ++tile_state.frames_since_keyframe;
+  }
+
+  tile_state.size =
+    keyframe && frame.data.isEmpty() ? QSize{} : image.size();
+  tile_state.hashes = std::move(hashes);
+
+  return frame;
+}
+
+QByteArray
+PreviewEncoder::encodeData(QImage image, const PreviewFormat &format) {
+  switch (format.codec) {
+    case PreviewCodec::Png:
+      return saveImage(image, "PNG", format.quality);
+
+    case PreviewCodec::FastPng:
+      return saveImage(image, "PNG", fast_png_quality);
+
+    case PreviewCodec::Jpeg:
+      return saveImage(image, "JPEG", format.quality);
+
+    case PreviewCodec::RawRgba:
+      image.convertTo(QImage::Format_RGBA8888);
+      return copyPixels(image);
+
+    case PreviewCodec::RawBgra:
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+      image.convertTo(QImage::Format_ARGB32);
+#else
+      image = image.convertToFormat(QImage::Format_RGBA8888).rgbSwapped();
+#endif
+      return copyPixels(image);
+  }
+
+  return {};
+}
+
+QThreadPool &PreviewEncoder::getThreadPool() {
+  static auto thread_pool = []() {
+    auto pool = std::make_unique<QThreadPool>();
+    pool->setMaxThreadCount(
+      qBound(1, QThread::idealThreadCount() / 2, max_thread_count));
+    pool->setThreadPriority(QThread::LowPriority);
+    return pool;
+  }();
+
+  return *thread_pool;
+}
+
+void PreviewEncoder::run(const std::shared_ptr<State> &state) {
+  while (true) {
+    auto image = QImage{};
+    auto format = PreviewFormat{};
+    auto keyframe = false;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (!state->pending) {
+        state->running = false;
+        return;
+      }
+
+      image = std::move(*state->pending);
+      format = state->format;
+      keyframe = std::exchange(state->keyframe_requested, false);
+      state->pending.reset();
+    }
+
+    const auto frame =
+      format.delta
+        ? encodeDelta(std::move(image), format, state->tile_state, keyframe)
+        : encode(std::move(image), format);
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (frame.data.isEmpty() && frame.tiles.empty()) continue;
+    if (state->sink) state->sink(frame);
+  }
+}
+
+}// namespace specter
@@ -2,53 +2,242 @@
 #include "specter/observe/preview/observer.h"
 
 #include "specter/module.h"
+#include "specter/observe/preview/encoder.h"
 #include "specter/search/utils.h"
 /* ------------------------------------ Qt ---------------------------------- */
 #include <QApplication>
-#include <QBuffer>
+#include <QChildEvent>
+#include <QUuid>
 #include <QWidget>
 /* --------------------------------- Standard ------------------------------- */
+#include <algorithm>
 #include <queue>
 #include <set>
+#include <tuple>
+#include <utility>
 /* -------------------------------------------------------------------------- */
 
+namespace {
+
+using PreviewKey =
+  std::tuple<QObject *, int, int, int, int, bool, int, int, int, int, int, int>;
+
+std::map<QString, specter::PreviewObserver *> &getObservers() {
+  static auto observers = std::map<QString, specter::PreviewObserver *>{};
+  return observers;
+}
+
+std::map<PreviewKey, std::weak_ptr<specter::PreviewObserver>> &
+getSharedObservers() {
+  static auto observers =
+    std::map<PreviewKey, std::weak_ptr<specter::PreviewObserver>>{};
+  return observers;
+}
+
+PreviewKey previewKey(
+  QObject *object, const specter::PreviewFormat &format,
+  const QRect &region) {
+  return std::make_tuple(
+    object, int(format.codec), format.quality, format.max_size.width(),
+    format.max_size.height(), format.delta, format.tile_size,
+    format.keyframe_interval, region.x(), region.y(), region.width(),
+    region.height());
+}
+
+std::chrono::milliseconds frameInterval(uint max_fps, int default_interval) {
+  return std::chrono::milliseconds(
+    max_fps > 0 ? qMax(1000 / int(max_fps), 1) : default_interval);
+}
+
+void mergePreview(
+  specter::PreviewFrame &preview, const specter::PreviewFrame &next) {
+  if (next.keyframe || next.size != preview.size) {
+    preview = next;
+    return;
+  }
+
+  for (const auto &tile : next.tiles) {
+    auto same_tile = std::find_if(
+      preview.tiles.begin(), preview.tiles.end(),
+      [&tile](const auto &other) { return other.rect == tile.rect; });
+
+    if (same_tile != preview.tiles.end()) same_tile->data = tile.data;
+    else preview.tiles.append(tile);
+  }
+}
+
+}// namespace
+
 namespace specter {
 
 /* ------------------------------ PreviewObserver --------------------------- */
 
+const int PreviewObserver::default_frame_interval_ms = 100;
+
+PreviewObserver *PreviewObserver::find(const QString &id) {
+  const auto &observers = getObservers();
+  const auto observer = observers.find(id);
+  return observer != observers.end() ? observer->second : nullptr;
+}
+
+std::shared_ptr<PreviewObserver> PreviewObserver::acquire(
+  QObject *object, const PreviewFormat &format, const QRect &region) {
+  auto &observers = getSharedObservers();
+  std::erase_if(
+    observers, [](const auto &observer) { return observer.second.expired(); });
+
+  const auto key = previewKey(object, format, region);
+  if (auto found = observers.find(key); found != observers.end()) {
+    auto observer = found->second.lock();
+    if (observer && observer->getObject() == object) return observer;
+  }
+
+  auto observer = std::make_shared<PreviewObserver>();
+  observer->setObject(object);
+  observer->setFormat(format);
+  observer->setRegion(region);
+  observer->start();
+
+  observers[key] = observer;
+  return observer;
+}
+
 PreviewObserver::PreviewObserver()
-    : m_object(nullptr), m_observing(false), m_check_timer(new QTimer(this)) {
-  m_check_timer->setInterval(100);
-  connect(
-    m_check_timer, &QTimer::timeout, this, &PreviewObserver::checkForChanges);
+    : m_id(QUuid::createUuid().toString(QUuid::WithoutBraces)),
+      m_object(nullptr), m_observing(false), m_dirty(false),
+      m_grabbing(false), m_paused(false),
+      m_frame_interval(default_frame_interval_ms), m_check_task(0) {
+  getObservers().emplace(m_id, this);
+
+  m_encoder = std::make_unique<PreviewEncoder>([this](const auto &preview) {
+    QMetaObject::invokeMethod(
+      this, [this, preview]() { Q_EMIT previewReported(preview); },
+      Qt::QueuedConnection);
+  });
 }
 
-PreviewObserver::~PreviewObserver() { stop(); }
+PreviewObserver::~PreviewObserver() {
+  stop();
+  m_encoder.reset();
+
+  getObservers().erase(m_id);
+}
+
+QString PreviewObserver::getId() const { return m_id; }
 
 void PreviewObserver::setObject(QObject *object) {
-  if (m_object != object) { m_object = object; }
+  if (m_object == object) return;
+
+  if (m_observing && m_object) unwatch(m_object);
+  m_object = object;
+  m_dirty = true;
+  if (m_observing && m_object) watch(m_object);
 }
 
 QObject *PreviewObserver::getObject() const { return m_object; }
 
+void PreviewObserver::setFormat(const PreviewFormat &format) {
+  m_encoder->setFormat(format);
+  m_dirty = true;
+}
+
+PreviewFormat PreviewObserver::getFormat() const {
+  return m_encoder->getFormat();
+}
+
+void PreviewObserver::setRegion(const QRect &region) {
+  m_region = region;
+  m_dirty = true;
+}
+
+QRect PreviewObserver::getRegion() const { return m_region; }
+
+void PreviewObserver::subscribe(PreviewObserverQueue *queue) {
+  m_subscribers.insert(queue);
+  updateSubscribers();
+  requestKeyframe();
+}
+
+void PreviewObserver::unsubscribe(PreviewObserverQueue *queue) {
+  m_subscribers.erase(queue);
+  updateSubscribers();
+}
+
+void PreviewObserver::updateSubscribers() {
+  auto paused = !m_subscribers.empty();
+  auto frame_interval = std::optional<std::chrono::milliseconds>{};
+
+  for (const auto subscriber : m_subscribers) {
+    const auto subscriber_interval =
+      frameInterval(subscriber->getMaxRate(), default_frame_interval_ms);
+
+    paused = paused && subscriber->isPaused();
+    frame_interval = frame_interval
+                       ? std::min(*frame_interval, subscriber_interval)
+                       : subscriber_interval;
+  }
+
+  m_paused = paused;
+  setFrameInterval(frame_interval.value_or(
+    std::chrono::milliseconds(default_frame_interval_ms)));
+}
+
+void PreviewObserver::requestKeyframe() {
+  m_encoder->requestKeyframe();
+  m_dirty = true;
+}
+
 void PreviewObserver::start() {
   if (m_observing) return;
 
   m_observing = true;
-  m_check_timer->start();
+  m_dirty = true;
+  if (m_object) watch(m_object);
+
+  m_check_task = scheduler().addPeriodicTask(
+    TaskPriority::Preview, m_frame_interval, [this]() { checkForChanges(); });
 }
 
 void PreviewObserver::stop() {
   if (!m_observing) return;
 
   m_observing = false;
-  m_check_timer->stop();
+  scheduler().removePeriodicTask(m_check_task);
+
+  if (m_object) unwatch(m_object);
 }
 
 bool PreviewObserver::isObserving() const { return m_observing; }
 
+quint64 PreviewObserver::getDroppedFrames() const {
+  return m_encoder->getDroppedFrames();
+}
+
+bool PreviewObserver::eventFilter(QObject *watched, QEvent *event) {
+  switch (event->type()) {
+    case QEvent::ChildAdded:
+      watch(static_cast<QChildEvent *>(event)->child());
+      break;
+
+    case QEvent::Paint:
+    case QEvent::UpdateRequest:
+    case QEvent::Resize:
+    case QEvent::Show:
+      if (!m_grabbing) m_dirty = true;
+      break;
+
+    default:
+      break;
+  }
+
+  return QObject::eventFilter(watched, event);
+}
+
 void PreviewObserver::checkForChanges() {
-  auto getImageData = [this]() -> QByteArray {
+  if (m_paused || !m_dirty) return;
+  m_dirty = false;
+
+  auto getImage = [this]() -> QImage {
     if (!m_object) { return {}; }
 
     QWidget *widget = qobject_cast<QWidget *>(m_object);
@@ -56,66 +245,171 @@ void PreviewObserver::checkForChanges() {
 
     if (!widget->isVisible() || widget->size().isEmpty()) { return {}; }
 
-    QPixmap pixmap = widget->grab();
-    if (pixmap.isNull()) { return {}; }
+    const auto region =
+      m_region.isNull() ? widget->rect() : m_region.intersected(widget->rect());
+    if (region.isEmpty()) { return {}; }
 
-    QByteArray imageData;
-    QBuffer buffer(&imageData);
-    if (!buffer.open(QIODevice::WriteOnly)) { return {}; }
+    m_grabbing = true;
+    QPixmap pixmap = widget->grab(region);
+    m_grabbing = false;
 
-    bool success = pixmap.save(&buffer, "PNG");
-    if (!success) { return {}; }
+    if (pixmap.isNull()) { return {}; }
 
-    return imageData;
+    return pixmap.toImage();
   };
 
-  Q_EMIT previewReported(getImageData());
+  auto image = getImage();
+  if (!image.isNull()) m_encoder->encode(std::move(image));
+}
+
+void PreviewObserver::setFrameInterval(
+  std::chrono::milliseconds frame_interval) {
+  if (m_frame_interval == frame_interval) return;
+  m_frame_interval = frame_interval;
+
+  if (!m_observing) return;
+
+  scheduler().removePeriodicTask(m_check_task);
+  m_check_task = scheduler().addPeriodicTask(
+    TaskPriority::Preview, m_frame_interval, [this]() { checkForChanges(); });
+}
+
+void PreviewObserver::watch(QObject *object) {
+  if (!object->isWidgetType()) return;
+
+  object->installEventFilter(this);
+  for (const auto child : object->children()) { watch(child); }
+}
+
+void PreviewObserver::unwatch(QObject *object) {
+  object->removeEventFilter(this);
+  for (const auto child : object->children()) { unwatch(child); }
 }
 
 /* ---------------------------- PreviewObserverQueue ----------------------- */
 
-PreviewObserverQueue::PreviewObserverQueue() : m_observer(nullptr) {}
+PreviewObserverQueue::PreviewObserverQueue()
+    : m_observer(nullptr), m_dropped_frames(0), m_seen_keyframe(false),
+      m_paused(false) {}
 
-PreviewObserverQueue::~PreviewObserverQueue() = default;
+PreviewObserverQueue::~PreviewObserverQueue() { setObserver(nullptr); }
 
 void PreviewObserverQueue::setObserver(PreviewObserver *observer) {
   if (m_observer) {
     m_observer->disconnect(m_on_preview_reported);
-    m_observed_previews.clear();
+    m_observer->unsubscribe(this);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_latest_preview.reset();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_seen_keyframe = false;
   }
 
   m_observer = observer;
 
   if (m_observer) {
+    m_observer->subscribe(this);
     m_on_preview_reported = QObject::connect(
       m_observer, &PreviewObserver::previewReported,
-      [this](const auto recorder_action) {
+      [this](const auto &preview) {
         {
           std::lock_guard<std::mutex> lock(m_mutex);
-          m_observed_previews.push_back(recorder_action);
+          pushPreview(preview);
         }
 
         m_cv.notify_one();
+        if (m_notifier) m_notifier();
       });
   }
 }
 
+void PreviewObserverQueue::setNotifier(std::function<void()> notifier) {
+  m_notifier = std::move(notifier);
+}
+
+void PreviewObserverQueue::setMaxRate(uint max_rate) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rate_limiter.setMaxRate(max_rate);
+  }
+
+  if (m_observer) m_observer->updateSubscribers();
+}
+
+void PreviewObserverQueue::setPaused(bool paused) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (std::exchange(m_paused, paused) == paused) return;
+  }
+
+  if (m_observer) m_observer->updateSubscribers();
+}
+
 bool PreviewObserverQueue::isEmpty() const {
   std::lock_guard<std::mutex> lock(m_mutex);
-  return m_observed_previews.empty();
+  return !m_latest_preview.has_value();
+}
+
+bool PreviewObserverQueue::isReady() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_latest_preview.has_value() && m_rate_limiter.isReady();
+}
+
+bool PreviewObserverQueue::isPaused() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_paused;
+}
+
+uint PreviewObserverQueue::getMaxRate() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_rate_limiter.getMaxRate();
+}
+
+std::chrono::milliseconds PreviewObserverQueue::getDelay() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_rate_limiter.getDelay();
 }
 
-QByteArray PreviewObserverQueue::popPreview() {
+quint64 PreviewObserverQueue::getDroppedFrames() const {
   std::lock_guard<std::mutex> lock(m_mutex);
-  Q_ASSERT(!m_observed_previews.empty());
-  return m_observed_previews.takeFirst();
+  return m_dropped_frames;
 }
 
-QByteArray PreviewObserverQueue::waitPopPreview() {
+PreviewFrame PreviewObserverQueue::popPreview() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Q_ASSERT(m_latest_preview.has_value());
+  return takePreview();
+}
+
+PreviewFrame PreviewObserverQueue::waitPopPreview() {
   std::unique_lock<std::mutex> lock(m_mutex);
-  m_cv.wait(lock, [this] { return !m_observed_previews.empty(); });
+  m_cv.wait(lock, [this] { return m_latest_preview.has_value(); });
+
+  return takePreview();
+}
+
+void PreviewObserverQueue::pushPreview(const PreviewFrame &preview) {
+  if (!m_seen_keyframe && !preview.keyframe) return;
+  m_seen_keyframe = true;
+
+  if (!m_latest_preview) {
+    m_latest_preview = preview;
+    return;
+  }
+
+  ++m_dropped_frames;
+  mergePreview(*m_latest_preview, preview);
+}
+
+PreviewFrame PreviewObserverQueue::takePreview() {
+  auto preview = std::move(*m_latest_preview);
+  m_latest_preview.reset();
 
-  return m_observed_previews.takeFirst();
+  m_rate_limiter.consume();
+  return preview;
 }
 
 }// namespace specter
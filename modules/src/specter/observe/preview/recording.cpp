@@ -0,0 +1,381 @@
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/observe/preview/recording.h"
+
+#include "specter/observe/preview/observer.h"
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QDateTime>
+#include <QDir>
+#include <QPainter>
+#include <QStandardPaths>
+/* --------------------------------- Standard ------------------------------- */
+#include <algorithm>
+#include <cstring>
+#include <limits>
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+qint64 alignedSize(qint64 size) { return (size + 7) & ~qint64(7); }
+
+QString &getRecordingDirectory() {
+  static auto directory =
+    QDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation))
+      .filePath(QStringLiteral("specter-recordings"));
+  return directory;
+}
+
+}// namespace
+
+namespace specter {
+
+/* --------------------------- PreviewRecordingFormat ----------------------- */
+
+const quint32 PreviewRecordingFormat::magic = 0x53504652;
+const quint32 PreviewRecordingFormat::version = 1;
+
+QString PreviewRecordingFormat::indexPath(const QString &path) {
+  return path + QStringLiteral(".index");
+}
+
+/* --------------------------- PreviewRecordingWriter ----------------------- */
+
+const qint64 PreviewRecordingWriter::grow_size = 16 * 1024 * 1024;
+
+PreviewRecordingWriter::PreviewRecordingWriter(const QString &path)
+    : m_file(path), m_index_file(PreviewRecordingFormat::indexPath(path)),
+      m_data(nullptr), m_capacity(0), m_offset(0) {}
+
+PreviewRecordingWriter::~PreviewRecordingWriter() { close(); }
+
+bool PreviewRecordingWriter::open() {
+  if (!m_file.open(QIODevice::ReadWrite | QIODevice::NewOnly)) return false;
+  if (!m_index_file.open(QIODevice::WriteOnly | QIODevice::NewOnly)) {
+    m_file.remove();
+    return false;
+  }
+
+  const auto header = PreviewRecordingFormat::Header{
+    PreviewRecordingFormat::magic, PreviewRecordingFormat::version,
+    QDateTime::currentMSecsSinceEpoch()};
+
+  if (!reserve(sizeof(header))) return false;
+  write(&header, sizeof(header));
+  return true;
+}
+
+void PreviewRecordingWriter::close() {
+  if (!m_file.isOpen()) return;
+
+  if (m_data) m_file.unmap(m_data);
+  m_data = nullptr;
+
+  m_file.resize(m_offset);
+  m_file.close();
+  m_index_file.close();
+}
+
+bool PreviewRecordingWriter::append(
+  const PreviewFrame &frame, qint64 timestamp) {
+  using Format = PreviewRecordingFormat;
+
+  auto size = qint64(sizeof(Format::RecordHeader)) + frame.data.size();
+  for (const auto &tile : frame.tiles) {
+    size += qint64(sizeof(Format::TileHeader)) + tile.data.size();
+  }
+  size = alignedSize(size);
+
+  if (!reserve(size)) return false;
+
+  const auto offset = m_offset;
+  const auto header = Format::RecordHeader{
+    quint32(size),
+    quint32(frame.tiles.size()),
+    timestamp,
+    quint32(frame.size.width()),
+    quint32(frame.size.height()),
+    quint32(frame.codec),
+    quint32(frame.data.size())};
+
+  m_offset = offset + qint64(sizeof(header));
+  write(frame.data.constData(), frame.data.size());
+
+  for (const auto &tile : frame.tiles) {
+    const auto tile_header = Format::TileHeader{
+      tile.rect.x(),          tile.rect.y(),
+      tile.rect.width(),      tile.rect.height(),
+      quint32(tile.data.size()), 0};
+
+    write(&tile_header, sizeof(tile_header));
+    write(tile.data.constData(), tile.data.size());
+  }
+
+  std::memcpy(m_data + offset, &header, sizeof(header));
+  m_offset = offset + size;
+
+  if (frame.keyframe) {
+    const auto entry = Format::IndexEntry{timestamp, offset};
+    m_index_file.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+    m_index_file.flush();
+  }
+
+  return true;
+}
+
+QString PreviewRecordingWriter::getErrorString() const {
+  return m_file.errorString();
+}
+
+bool PreviewRecordingWriter::reserve(qint64 size) {
+  if (m_offset + size <= m_capacity) return true;
+
+  if (m_data) m_file.unmap(m_data);
+  m_data = nullptr;
+
+  const auto capacity =
+    m_capacity + std::max(grow_size, alignedSize(size + grow_size));
+  if (!m_file.resize(capacity)) return false;
+
+  m_data = m_file.map(0, capacity);
+  if (!m_data) return false;
+
+  m_capacity = capacity;
+  return true;
+}
+
+void PreviewRecordingWriter::write(const void *data, qint64 size) {
+  std::memcpy(m_data + m_offset, data, size);
+  m_offset += size;
+}
+
+/* --------------------------- PreviewRecordingReader ----------------------- */
+
+const quint32 PreviewRecordingReader::max_dimension = 32768;
+
+PreviewRecordingReader::PreviewRecordingReader(const QString &path)
+    : m_file(path), m_index_file(PreviewRecordingFormat::indexPath(path)) {}
+
+PreviewRecordingReader::~PreviewRecordingReader() = default;
+
+bool PreviewRecordingReader::open() {
+  using Format = PreviewRecordingFormat;
+
+  if (!m_file.open(QIODevice::ReadOnly)) {
+    m_error = m_file.errorString();
+    return false;
+  }
+
+  if (!m_index_file.open(QIODevice::ReadOnly)) {
+    m_error = m_index_file.errorString();
+    return false;
+  }
+
+  const auto header = read<Format::Header>(0);
+  if (
+    !header || header->magic != Format::magic ||
+    header->version != Format::version) {
+    m_error = QStringLiteral("The recording header is malformed");
+    return false;
+  }
+
+  const auto index = m_index_file.readAll();
+  const auto entry_size = qsizetype(sizeof(Format::IndexEntry));
+  m_index.resize(index.size() / entry_size);
+  std::memcpy(m_index.data(), index.constData(), m_index.size() * entry_size);
+
+  const auto size = m_file.size();
+  auto previous =
+    Format::IndexEntry{std::numeric_limits<qint64>::min(), qint64{0}};
+  for (const auto &entry : m_index) {
+    if (
+      entry.offset < qint64(sizeof(Format::Header)) || entry.offset >= size ||
+      entry.offset <= previous.offset ||
+      entry.timestamp < previous.timestamp) {
+      m_error = QStringLiteral("The recording index is malformed");
+      return false;
+    }
+
+    previous = entry;
+  }
+
+  return true;
+}
+
+std::optional<PreviewRecorded>
+PreviewRecordingReader::readFrame(qint64 timestamp) {
+  using Format = PreviewRecordingFormat;
+
+  auto keyframe = std::upper_bound(
+    m_index.cbegin(), m_index.cend(), timestamp,
+    [](qint64 value, const auto &entry) { return value < entry.timestamp; });
+  if (keyframe == m_index.cbegin()) return std::nullopt;
+  --keyframe;
+
+  auto recorded = PreviewRecorded{};
+  auto offset = keyframe->offset;
+
+  while (const auto header = read<Format::RecordHeader>(offset)) {
+    if (header->size == 0 || header->timestamp > timestamp) break;
+
+    if (!readRecord(*header, offset, recorded)) {
+      m_error = QStringLiteral("The recorded frame at offset %1 is malformed")
+                  .arg(offset);
+      return std::nullopt;
+    }
+
+    offset += header->size;
+  }
+
+  if (recorded.image.isNull()) return std::nullopt;
+  return recorded;
+}
+
+QString PreviewRecordingReader::getErrorString() const { return m_error; }
+
+bool PreviewRecordingReader::readRecord(
+  const PreviewRecordingFormat::RecordHeader &header, qint64 offset,
+  PreviewRecorded &recorded) {
+  using Format = PreviewRecordingFormat;
+
+  const auto header_size = qint64(sizeof(Format::RecordHeader));
+  if (header.size < header_size || offset + header.size > m_file.size()) {
+    return false;
+  }
+
+  if (
+    header.codec > quint32(PreviewCodec::RawBgra) || header.width == 0 ||
+    header.height == 0 || header.width > max_dimension ||
+    header.height > max_dimension) {
+    return false;
+  }
+
+  if (!m_file.seek(offset + header_size)) return false;
+  const auto body = m_file.read(header.size - header_size);
+  if (body.size() != header.size - header_size) return false;
+
+  auto position = qsizetype{0};
+  const auto take = [&body, &position](qint64 length) {
+    if (length > body.size() - position) return std::optional<QByteArray>{};
+
+    const auto data =
+      QByteArray::fromRawData(body.constData() + position, length);
+    position += length;
+    return std::optional<QByteArray>(data);
+  };
+
+  const auto codec = static_cast<PreviewCodec>(header.codec);
+  const auto size = QSize(int(header.width), int(header.height));
+
+  if (header.data_size > 0) {
+    const auto data = take(header.data_size);
+    if (!data) return false;
+
+    recorded.image = PreviewEncoder::decode(*data, size, codec);
+    if (recorded.image.depth() != 32) {
+      recorded.image.convertTo(QImage::Format_ARGB32_Premultiplied);
+    }
+  }
+
+  if (recorded.image.isNull()) return false;
+
+  if (header.tile_count > 0) {
+    QPainter painter(&recorded.image);
+    for (auto i = quint32{0}; i < header.tile_count; ++i) {
+      const auto tile_data = take(sizeof(Format::TileHeader));
+      if (!tile_data) return false;
+
+      auto tile = Format::TileHeader{};
+      std::memcpy(&tile, tile_data->constData(), sizeof(tile));
+
+      const auto rect = QRect(tile.x, tile.y, tile.width, tile.height);
+      if (rect.isEmpty() || !recorded.image.rect().contains(rect)) {
+        return false;
+      }
+
+      const auto data = take(tile.data_size);
+      if (!data) return false;
+
+      const auto image = PreviewEncoder::decode(*data, rect.size(), codec);
+      if (image.isNull()) return false;
+
+      painter.drawImage(rect.topLeft(), image);
+    }
+  }
+
+  recorded.timestamp = header.timestamp;
+  return true;
+}
+
+template<typename T>
+std::optional<T> PreviewRecordingReader::read(qint64 offset) {
+  if (offset < 0 || !m_file.seek(offset)) return std::nullopt;
+
+  auto value = T{};
+  const auto data = reinterpret_cast<char *>(&value);
+  if (m_file.read(data, sizeof(T)) != qint64(sizeof(T))) return std::nullopt;
+
+  return value;
+}
+
+/* ------------------------------ PreviewRecording -------------------------- */
+
+QString PreviewRecording::getDirectory() { return getRecordingDirectory(); }
+
+void PreviewRecording::setDirectory(const QString &directory) {
+  getRecordingDirectory() = directory;
+}
+
+QString PreviewRecording::getRecordingPath(const QString &id) {
+  return QDir(getRecordingDirectory()).filePath(id + QStringLiteral(".rec"));
+}
+
+PreviewRecording::PreviewRecording(const QString &path)
+    : m_path(path),
+      m_observer_queue(std::make_unique<PreviewObserverQueue>()) {
+  m_observer_queue->setNotifier([this]() { writePending(); });
+}
+
+PreviewRecording::~PreviewRecording() { stop(); }
+
+bool PreviewRecording::start(
+  QObject *object, const PreviewFormat &format, uint max_fps) {
+  m_writer = std::make_unique<PreviewRecordingWriter>(m_path);
+  if (!m_writer->open()) {
+    m_error = m_writer->getErrorString();
+    m_writer.reset();
+    return false;
+  }
+
+  auto recording_format = format;
+  recording_format.delta = true;
+
+  m_timer.start();
+  m_observer = PreviewObserver::acquire(object, recording_format, QRect{});
+  m_observer_queue->setMaxRate(max_fps);
+  m_observer_queue->setObserver(m_observer.get());
+  return true;
+}
+
+void PreviewRecording::stop() {
+  m_observer_queue->setObserver(nullptr);
+  m_observer.reset();
+
+  if (m_writer) m_writer->close();
+  m_writer.reset();
+}
+
+QString PreviewRecording::getPath() const { return m_path; }
+
+QString PreviewRecording::getErrorString() const { return m_error; }
+
+void PreviewRecording::writePending() {
+  if (!m_writer || m_observer_queue->isEmpty()) return;
+
+  const auto preview = m_observer_queue->popPreview();
+  if (!m_writer->append(preview, m_timer.elapsed())) {
+    m_error = m_writer->getErrorString();
+    m_writer->close();
+    m_writer.reset();
+  }
+}
+
+}// namespace specter
@@ -0,0 +1,89 @@
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/observe/preview/ring.h"
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QUuid>
+/* --------------------------------- Standard ------------------------------- */
+#include <atomic>
+#include <cstring>
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* -------------------------------- PreviewRing ----------------------------- */
+
+const quint32 PreviewRing::magic = 0x53505252;
+const quint32 PreviewRing::version = 1;
+const quint32 PreviewRing::default_slot_count = 3;
+const quint32 PreviewRing::default_slot_size = 16 * 1024 * 1024;
+const quint32 PreviewRing::max_slot_count = 8;
+const quint32 PreviewRing::max_slot_size = 64 * 1024 * 1024;
+
+PreviewRing::PreviewRing(quint32 slot_count, quint32 slot_size)
+    : m_memory(
+        QStringLiteral("specter-preview-%1")
+          .arg(QUuid::createUuid().toString(QUuid::WithoutBraces))),
+      m_slot_count(
+        slot_count > 0 ? qMin(slot_count, max_slot_count) : default_slot_count),
+      m_slot_size(
+        slot_size > 0 ? (qMin(slot_size, max_slot_size) + 7) & ~7u
+                      : default_slot_size),
+      m_sequence(0) {}
+
+PreviewRing::~PreviewRing() = default;
+
+bool PreviewRing::create() {
+  const auto slot_stride = qsizetype(sizeof(SlotHeader)) + m_slot_size;
+  const auto size = qsizetype(sizeof(Header)) + slot_stride * m_slot_count;
+  if (!m_memory.create(size)) return false;
+
+  auto header = static_cast<Header *>(m_memory.data());
+  header->magic = magic;
+  header->version = version;
+  header->slot_count = m_slot_count;
+  header->slot_size = m_slot_size;
+
+  for (auto i = quint32{0}; i < m_slot_count; ++i) {
+    auto slot_header = reinterpret_cast<SlotHeader *>(slotData(i));
+    std::memset(slot_header, 0, sizeof(SlotHeader));
+  }
+
+  return true;
+}
+
+QString PreviewRing::getKey() const { return m_memory.nativeKey(); }
+
+QString PreviewRing::getErrorString() const { return m_memory.errorString(); }
+
+std::optional<PreviewRingSlot> PreviewRing::write(const PreviewFrame &frame) {
+  if (!m_memory.isAttached()) return std::nullopt;
+  if (quint32(frame.data.size()) > m_slot_size) return std::nullopt;
+
+  const auto sequence = ++m_sequence;
+  const auto index = quint32((sequence - 1) % m_slot_count);
+
+  auto data = slotData(index);
+  auto slot_header = reinterpret_cast<SlotHeader *>(data);
+  auto slot_sequence = std::atomic_ref<quint64>(slot_header->sequence);
+
+  slot_sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot_header->width = quint32(frame.size.width());
+  slot_header->height = quint32(frame.size.height());
+  slot_header->codec = quint32(frame.codec);
+  slot_header->size = quint32(frame.data.size());
+  std::memcpy(
+    data + sizeof(SlotHeader), frame.data.constData(), frame.data.size());
+
+  slot_sequence.store(sequence, std::memory_order_release);
+
+  return PreviewRingSlot{index, sequence, quint32(frame.data.size())};
+}
+
+char *PreviewRing::slotData(quint32 index) {
+  const auto slot_stride = qsizetype(sizeof(SlotHeader)) + m_slot_size;
+  return static_cast<char *>(m_memory.data()) + sizeof(Header) +
+         slot_stride * index;
+}
+
+}// namespace specter
@@ -6,4 +6,18 @@ namespace specter {
 
 std::size_t PropertyObservedAction::index() const { return m_data.index(); }
 
+QString PropertyObservedAction::getProperty() const {
+  return std::visit([](const auto &action) { return action.property; }, m_data);
+}
+
+bool PropertyObservedAction::coalesce(const PropertyObservedAction &action) {
+  const auto pending = std::get_if<PropertyUpdated>(&m_data);
+  const auto next = action.getIf<PropertyUpdated>();
+  if (!pending || !next || pending->property != next->property) return false;
+
+  pending->new_value = next->new_value;
+  pending->skipped_updates += next->skipped_updates + 1;
+  return true;
+}
+
 }// namespace specter
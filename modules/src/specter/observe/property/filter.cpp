@@ -0,0 +1,76 @@
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/observe/property/filter.h"
+
+#include "specter/reflect/cache.h"
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QCache>
+/* --------------------------------- Standard ------------------------------- */
+#include <algorithm>
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using PropertyIndicesKey = QPair<const QMetaObject *, QString>;
+
+const auto max_cached_filters = 1024;
+
+QCache<PropertyIndicesKey, QList<int>> &getPropertyIndicesCache() {
+  static auto cache =
+    QCache<PropertyIndicesKey, QList<int>>{max_cached_filters};
+  return cache;
+}
+
+}// namespace
+
+namespace specter {
+
+/* ------------------------------- PropertyFilter --------------------------- */
+
+PropertyFilter::PropertyFilter(const QStringList &patterns)
+    : m_key(patterns.join(QLatin1Char('\n'))) {
+  for (const auto &pattern : patterns) {
+    if (
+      pattern.contains(QLatin1Char('*')) ||
+      pattern.contains(QLatin1Char('?'))) {
+      m_patterns.append(QRegularExpression(
+        QRegularExpression::wildcardToRegularExpression(pattern),
+        QRegularExpression::DontCaptureOption));
+      m_patterns.last().optimize();
+    } else {
+      m_names.append(pattern);
+    }
+  }
+}
+
+PropertyFilter::~PropertyFilter() = default;
+
+bool PropertyFilter::isEmpty() const {
+  return m_names.empty() && m_patterns.empty();
+}
+
+bool PropertyFilter::matches(const QString &name) const {
+  if (isEmpty() || m_names.contains(name)) return true;
+
+  return std::any_of(
+    m_patterns.begin(), m_patterns.end(), [&name](const auto &pattern) {
+      return pattern.match(name).hasMatch();
+    });
+}
+
+QList<int>
+PropertyFilter::getPropertyIndices(const QMetaObject *meta_object) const {
+  auto &cache = getPropertyIndicesCache();
+  const auto key = PropertyIndicesKey{meta_object, m_key};
+  if (const auto indices = cache.object(key); indices) return *indices;
+
+  auto indices = QList<int>{};
+  const auto &reflection = ReflectionCache::get(meta_object);
+  for (const auto &property : reflection.getProperties()) {
+    if (matches(property.name)) indices.append(property.index);
+  }
+
+  cache.insert(key, new QList<int>(indices));
+  return indices;
+}
+
+}// namespace specter
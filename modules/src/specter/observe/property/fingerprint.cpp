@@ -0,0 +1,94 @@
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/observe/property/fingerprint.h"
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QBitmap>
+#include <QFont>
+#include <QHashFunctions>
+#include <QIcon>
+#include <QImage>
+#include <QPixmap>
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* ------------------------------ ValueFingerprint -------------------------- */
+
+const qsizetype ValueFingerprint::min_container_size = 1024;
+
+bool ValueFingerprint::isSupported(const QVariant &value) {
+  switch (value.userType()) {
+    case QMetaType::QPixmap:
+    case QMetaType::QBitmap:
+    case QMetaType::QIcon:
+    case QMetaType::QImage:
+    case QMetaType::QFont:
+      return true;
+    case QMetaType::QByteArray:
+      return value.toByteArray().size() >= min_container_size;
+    case QMetaType::QString:
+      return value.toString().size() >= min_container_size;
+    case QMetaType::QStringList:
+      return value.toStringList().size() >= min_container_size;
+    default:
+      return false;
+  }
+}
+
+ValueFingerprint::ValueFingerprint(const QVariant &value)
+    : m_type(value.userType()), m_generation(generation(value)),
+      m_hash(hash(value)) {}
+
+ValueFingerprint::~ValueFingerprint() = default;
+
+bool ValueFingerprint::matches(const QVariant &value) const {
+  if (value.userType() != m_type) return false;
+  if (m_generation != 0 && generation(value) == m_generation) return true;
+
+  return hash(value) == m_hash;
+}
+
+qint64 ValueFingerprint::generation(const QVariant &value) {
+  switch (value.userType()) {
+    case QMetaType::QPixmap:
+      return value.value<QPixmap>().cacheKey();
+    case QMetaType::QBitmap:
+      return value.value<QBitmap>().cacheKey();
+    case QMetaType::QIcon:
+      return value.value<QIcon>().cacheKey();
+    case QMetaType::QImage:
+      return value.value<QImage>().cacheKey();
+    default:
+      return 0;
+  }
+}
+
+size_t ValueFingerprint::hash(const QVariant &value) {
+  switch (value.userType()) {
+    case QMetaType::QPixmap:
+    case QMetaType::QBitmap:
+    case QMetaType::QIcon:
+      return qHash(generation(value));
+    case QMetaType::QImage: {
+      const auto image = value.value<QImage>();
+      if (image.isNull()) return 0;
+
+      const auto header = qHashMulti(
+        0, image.width(), image.height(), int(image.format()));
+      return qHashBits(image.constBits(), image.sizeInBytes(), header);
+    }
+    case QMetaType::QFont:
+      return qHash(value.value<QFont>());
+    case QMetaType::QByteArray:
+      return qHash(value.toByteArray());
+    case QMetaType::QString:
+      return qHash(value.toString());
+    case QMetaType::QStringList: {
+      const auto strings = value.toStringList();
+      return qHashRange(strings.begin(), strings.end());
+    }
+    default:
+      return 0;
+  }
+}
+
+}// namespace specter
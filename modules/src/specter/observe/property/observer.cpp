@@ -6,12 +6,6 @@
 /* ------------------------------------ Qt ---------------------------------- */
 #include <QApplication>
 #include <QBrush>
-#include <QFont>
-#include <QIcon>
-#include <QMetaProperty>
-/* --------------------------------- Standard ------------------------------- */
-#include <queue>
-#include <set>
 /* -------------------------------------------------------------------------- */
 
 namespace specter {
@@ -19,97 +13,152 @@ namespace specter {
 /* ------------------------------ PropertyObserver -------------------------- */
 
 PropertyObserver::PropertyObserver()
-    : m_object(nullptr), m_observing(false), m_check_timer(new QTimer(this)) {
-  m_check_timer->setInterval(100);
-  connect(
-    m_check_timer, &QTimer::timeout, this, &PropertyObserver::checkForChanges);
-}
+    : m_object(nullptr), m_observing(false), m_check_task(0),
+      m_polling_interval(std::chrono::milliseconds(500)) {}
 
 PropertyObserver::~PropertyObserver() { stop(); }
 
 void PropertyObserver::setObject(QObject *object) {
-  if (m_object != object) {
-    m_object = object;
-    m_tracked_properties = getTrackedProperties();
-  }
+  if (m_object == object) return;
+
+  if (m_observing) untrackProperties();
+  m_object = object;
+  if (m_observing) trackProperties();
 }
 
 QObject *PropertyObserver::getObject() const { return m_object; }
 
+void PropertyObserver::setFilter(const PropertyFilter &filter) {
+  if (m_observing) untrackProperties();
+  m_filter = filter;
+  if (m_observing) trackProperties();
+}
+
+const PropertyFilter &PropertyObserver::getFilter() const { return m_filter; }
+
+void PropertyObserver::setPollingInterval(
+  std::chrono::milliseconds interval) {
+  if (m_polling_interval == interval) return;
+  m_polling_interval = interval;
+
+  if (!m_observing) return;
+
+  scheduler().removePeriodicTask(m_check_task);
+  m_check_task = scheduler().addPeriodicTask(
+    TaskPriority::Stream, m_polling_interval,
+    [this]() { checkForPolledChanges(); });
+}
+
+std::chrono::milliseconds PropertyObserver::getPollingInterval() const {
+  return m_polling_interval;
+}
+
 void PropertyObserver::start() { startChangesTracker(); }
 
 void PropertyObserver::stop() { stopChangesTracker(); }
 
 bool PropertyObserver::isObserving() const { return m_observing; }
 
+void PropertyObserver::onNotifySignal() {
+  if (!m_object || sender() != m_object) return;
+
+  const auto properties = m_notify_signals.value(senderSignalIndex());
+  for (const auto property_index : properties) {
+    checkForChange(m_tracked_properties.at(property_index));
+  }
+}
+
 void PropertyObserver::startChangesTracker() {
   if (m_observing) return;
 
   m_observing = true;
-  m_check_timer->start();
-  m_tracked_properties = getTrackedProperties();
+  m_check_task = scheduler().addPeriodicTask(
+    TaskPriority::Stream, m_polling_interval,
+    [this]() { checkForPolledChanges(); });
+  trackProperties();
 }
 
 void PropertyObserver::stopChangesTracker() {
   if (!m_observing) return;
 
   m_observing = false;
-  m_check_timer->stop();
-  m_tracked_properties.clear();
+  scheduler().removePeriodicTask(m_check_task);
+  untrackProperties();
 }
 
-void PropertyObserver::checkForChanges() {
+void PropertyObserver::checkForPolledChanges() {
   if (!m_object) return;
 
-  auto current_properties = getTrackedProperties();
-  for (const auto &old_prop : m_tracked_properties) {
-    if (!current_properties.contains(old_prop.first)) {
-      Q_EMIT actionReported(
-        PropertyObservedAction::PropertyRemoved{old_prop.first});
-    }
+  for (const auto property_index : m_polled_properties) {
+    checkForChange(m_tracked_properties.at(property_index));
   }
+}
 
-  for (const auto &cur_prop : current_properties) {
-    if (!m_tracked_properties.contains(cur_prop.first)) {
-      auto property_index = m_object->metaObject()->indexOfProperty(
-        cur_prop.first.toUtf8().constData());
-      auto read_only =
-        !m_object->metaObject()->property(property_index).isWritable();
-
-      Q_EMIT actionReported(
-        PropertyObservedAction::PropertyAdded{
-          cur_prop.first, cur_prop.second, read_only});
-    } else {
-      const auto &old_value = m_tracked_properties[cur_prop.first];
-      if (!variantEqual(old_value, cur_prop.second)) {
-        Q_EMIT actionReported(
-          PropertyObservedAction::PropertyUpdated{
-            cur_prop.first, old_value, cur_prop.second});
-      }
-    }
-  }
+void PropertyObserver::checkForChange(TrackedProperty &tracked_property) {
+  const auto value = tracked_property.property.read(m_object);
+  const auto unchanged =
+    tracked_property.fingerprint
+      ? tracked_property.fingerprint->matches(value)
+      : variantEqual(tracked_property.value, value);
+  if (unchanged) return;
+
+  Q_EMIT actionReported(
+    PropertyObservedAction::PropertyUpdated{
+      tracked_property.name, tracked_property.value, value});
+  storeValue(tracked_property, value);
+}
 
-  m_tracked_properties = current_properties;
+void PropertyObserver::storeValue(
+  TrackedProperty &tracked_property, const QVariant &value) {
+  if (ValueFingerprint::isSupported(value)) {
+    tracked_property.fingerprint.emplace(value);
+    tracked_property.value = QVariant{};
+  } else {
+    tracked_property.fingerprint.reset();
+    tracked_property.value = value;
+  }
 }
 
-std::map<QString, QVariant> PropertyObserver::getTrackedProperties() const {
-  if (!m_object) return {};
+void PropertyObserver::trackProperties() {
+  static const auto on_notify_signal =
+    PropertyObserver::staticMetaObject.method(
+      PropertyObserver::staticMetaObject.indexOfSlot("onNotifySignal()"));
 
-  auto unique_properties = std::set<QString>{};
-  auto meta_object = m_object->metaObject();
-  for (auto i = 0; i < meta_object->propertyCount(); ++i) {
-    const auto name = meta_object->property(i).name();
-    unique_properties.insert(name);
-  }
+  if (!m_object) return;
+
+  const auto meta_object = m_object->metaObject();
+  const auto property_indices = m_filter.getPropertyIndices(meta_object);
+  for (const auto property_index : property_indices) {
+    const auto property = meta_object->property(property_index);
+    auto &tracked_property =
+      m_tracked_properties
+        .emplace(
+          property_index,
+          TrackedProperty{property, QString::fromLatin1(property.name())})
+        .first->second;
+    storeValue(tracked_property, property.read(m_object));
+
+    if (!property.hasNotifySignal()) {
+      m_polled_properties.append(property_index);
+      continue;
+    }
+
+    auto &notified_properties =
+      m_notify_signals[property.notifySignalIndex()];
+    if (notified_properties.empty()) {
+      connect(m_object, property.notifySignal(), this, on_notify_signal);
+    }
 
-  auto tracked_properties = std::map<QString, QVariant>{};
-  for (auto unique_property : unique_properties) {
-    const auto value =
-      m_object->property(unique_property.toStdString().c_str());
-    tracked_properties[unique_property] = value;
+    notified_properties.append(property_index);
   }
+}
+
+void PropertyObserver::untrackProperties() {
+  if (m_object) disconnect(m_object, nullptr, this, nullptr);
 
-  return tracked_properties;
+  m_tracked_properties.clear();
+  m_notify_signals.clear();
+  m_polled_properties.clear();
 }
 
 bool PropertyObserver::variantEqual(
@@ -117,31 +166,11 @@ bool PropertyObserver::variantEqual(
   if (a.userType() != b.userType()) return false;
 
   switch (a.userType()) {
-    case QMetaType::QIcon: {
-      QIcon iconA = a.value<QIcon>();
-      QIcon iconB = b.value<QIcon>();
-      return iconA.cacheKey() == iconB.cacheKey();
-    }
-    case QMetaType::QPixmap: {
-      QPixmap pxA = a.value<QPixmap>();
-      QPixmap pxB = b.value<QPixmap>();
-      return pxA.cacheKey() == pxB.cacheKey();
-    }
-    case QMetaType::QImage: {
-      QImage imgA = a.value<QImage>();
-      QImage imgB = b.value<QImage>();
-      return imgA == imgB;
-    }
     case QMetaType::QBrush: {
       QBrush brushA = a.value<QBrush>();
       QBrush brushB = b.value<QBrush>();
       return brushA == brushB;
     }
-    case QMetaType::QFont: {
-      QFont f1 = a.value<QFont>();
-      QFont f2 = b.value<QFont>();
-      return f1 == f2;
-    }
 
     default:
       return a == b;
@@ -150,14 +179,18 @@ bool PropertyObserver::variantEqual(
 
 /* ---------------------------- PropertyObserverQueue ----------------------- */
 
-PropertyObserverQueue::PropertyObserverQueue() : m_observer(nullptr) {}
+PropertyObserverQueue::PropertyObserverQueue()
+    : m_observer(nullptr), m_popped_actions(0) {}
 
 PropertyObserverQueue::~PropertyObserverQueue() = default;
 
 void PropertyObserverQueue::setObserver(PropertyObserver *observer) {
   if (m_observer) {
     m_observer->disconnect(m_on_action_reported);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_observed_actions.clear();
+    m_pending_updates.clear();
   }
 
   m_observer = observer;
@@ -168,30 +201,82 @@ void PropertyObserverQueue::setObserver(PropertyObserver *observer) {
       [this](const auto recorder_action) {
         {
           std::lock_guard<std::mutex> lock(m_mutex);
-          m_observed_actions.push_back(recorder_action);
+          pushAction(recorder_action);
         }
 
         m_cv.notify_one();
+        if (m_notifier) m_notifier();
       });
   }
 }
 
+void PropertyObserverQueue::setNotifier(std::function<void()> notifier) {
+  m_notifier = std::move(notifier);
+}
+
+void PropertyObserverQueue::setMaxRate(uint max_rate) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_rate_limiter.setMaxRate(max_rate);
+}
+
 bool PropertyObserverQueue::isEmpty() const {
   std::lock_guard<std::mutex> lock(m_mutex);
   return m_observed_actions.empty();
 }
 
+bool PropertyObserverQueue::isReady() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return !m_observed_actions.empty() && m_rate_limiter.isReady();
+}
+
+std::chrono::milliseconds PropertyObserverQueue::getDelay() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_rate_limiter.getDelay();
+}
+
 PropertyObservedAction PropertyObserverQueue::popAction() {
   std::lock_guard<std::mutex> lock(m_mutex);
   Q_ASSERT(!m_observed_actions.empty());
-  return m_observed_actions.takeFirst();
+  return takeAction();
 }
 
 PropertyObservedAction PropertyObserverQueue::waitPopAction() {
   std::unique_lock<std::mutex> lock(m_mutex);
   m_cv.wait(lock, [this] { return !m_observed_actions.empty(); });
 
-  return m_observed_actions.takeFirst();
+  return takeAction();
+}
+
+void PropertyObserverQueue::pushAction(const PropertyObservedAction &action) {
+  const auto property = action.getProperty();
+  const auto pending_update = m_pending_updates.constFind(property);
+  if (pending_update != m_pending_updates.constEnd()) {
+    auto &pending_action =
+      m_observed_actions[*pending_update - m_popped_actions];
+    if (pending_action.coalesce(action)) return;
+
+    m_pending_updates.erase(pending_update);
+  }
+
+  m_observed_actions.push_back(action);
+  if (action.is<PropertyObservedAction::PropertyUpdated>()) {
+    m_pending_updates.insert(
+      property, m_popped_actions + m_observed_actions.size() - 1);
+  }
+}
+
+PropertyObservedAction PropertyObserverQueue::takeAction() {
+  auto action = std::move(m_observed_actions.front());
+  m_observed_actions.pop_front();
+
+  const auto position = m_popped_actions++;
+  const auto property = action.getProperty();
+  if (m_pending_updates.value(property, position + 1) == position) {
+    m_pending_updates.remove(property);
+  }
+
+  m_rate_limiter.consume();
+  return action;
 }
 
 }// namespace specter
@@ -0,0 +1,264 @@
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/observe/property/subscription.h"
+
+#include "specter/module.h"
+#include "specter/observe/property/observer.h"
+#include "specter/search/utils.h"
+/* ------------------------------------ Qt ---------------------------------- */
+#include <QUuid>
+/* --------------------------------- Standard ------------------------------- */
+#include <utility>
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+std::map<QString, specter::PropertySubscription *> &getSubscriptions() {
+  static auto subscriptions =
+    std::map<QString, specter::PropertySubscription *>{};
+  return subscriptions;
+}
+
+}// namespace
+
+namespace specter {
+
+/* ---------------------------- PropertyObserverPool ------------------------ */
+
+std::shared_ptr<PropertyObserver>
+PropertyObserverPool::acquire(QObject *object) {
+  auto &observer_ref = getObservers()[object];
+  if (auto observer = observer_ref.lock(); observer) {
+    if (observer->getObject() == object) return observer;
+  }
+
+  auto observer = std::shared_ptr<PropertyObserver>(
+    new PropertyObserver(), [object](PropertyObserver *observer) {
+      auto &observers = getObservers();
+      auto observer_ref = observers.find(object);
+      if (observer_ref != observers.end() && observer_ref->second.expired()) {
+        observers.erase(observer_ref);
+      }
+
+      delete observer;
+    });
+
+  observer->setObject(object);
+  observer->start();
+
+  observer_ref = observer;
+  return observer;
+}
+
+std::map<QObject *, std::weak_ptr<PropertyObserver>> &
+PropertyObserverPool::getObservers() {
+  static auto observers =
+    std::map<QObject *, std::weak_ptr<PropertyObserver>>{};
+  return observers;
+}
+
+/* ---------------------------- PropertySubscription ------------------------ */
+
+const int PropertySubscription::query_resolve_interval_ms = 1000;
+
+PropertySubscription *PropertySubscription::find(const QString &id) {
+  const auto &subscriptions = getSubscriptions();
+  const auto subscription = subscriptions.find(id);
+  return subscription != subscriptions.end() ? subscription->second : nullptr;
+}
+
+PropertySubscription::PropertySubscription()
+    : m_id(QUuid::createUuid().toString(QUuid::WithoutBraces)),
+      m_resolve_task(0) {
+  getSubscriptions().emplace(m_id, this);
+
+  m_resolve_task = scheduler().addPeriodicTask(
+    TaskPriority::Stream, std::chrono::milliseconds(100),
+    [this]() { resolveQueries(); });
+}
+
+PropertySubscription::~PropertySubscription() {
+  scheduler().removePeriodicTask(m_resolve_task);
+
+  for (const auto &[object, subscriber] : m_subscribers) {
+    disconnect(subscriber.on_action_reported);
+    disconnect(subscriber.on_destroyed);
+  }
+
+  getSubscriptions().erase(m_id);
+}
+
+QString PropertySubscription::getId() const { return m_id; }
+
+void PropertySubscription::addObject(QObject *object) {
+  subscribe(object).explicit_object = true;
+}
+
+void PropertySubscription::removeObject(const ObjectId &object_id) {
+  for (auto &[object, subscriber] : m_subscribers) {
+    if (subscriber.object_id == object_id) subscriber.explicit_object = false;
+  }
+
+  unsubscribeUnused();
+}
+
+void PropertySubscription::addQuery(const ObjectQuery &query) {
+  if (m_queries.try_emplace(query.toString(), query).second) {
+    restartQueryResolution();
+  }
+}
+
+void PropertySubscription::removeQuery(const ObjectQuery &query) {
+  const auto key = query.toString();
+  if (m_queries.erase(key) == 0) return;
+
+  for (auto &[object, subscriber] : m_subscribers) {
+    subscriber.queries.remove(key);
+  }
+
+  unsubscribeUnused();
+  restartQueryResolution();
+}
+
+void PropertySubscription::setMaxRate(uint max_rate) {
+  m_rate_limiter.setMaxRate(max_rate);
+}
+
+bool PropertySubscription::hasChanges() const { return !m_changes.empty(); }
+
+bool PropertySubscription::isReady() const {
+  return hasChanges() && m_rate_limiter.isReady();
+}
+
+std::chrono::milliseconds PropertySubscription::getDelay() const {
+  return m_rate_limiter.getDelay();
+}
+
+QList<PropertySubscription::ObjectChange> PropertySubscription::takeChanges() {
+  m_rate_limiter.consume();
+  m_pending_updates.clear();
+
+  return std::exchange(m_changes, {});
+}
+
+PropertySubscription::Subscriber &
+PropertySubscription::subscribe(QObject *object) {
+  auto [subscriber_iter, inserted] = m_subscribers.try_emplace(object);
+  auto &subscriber = subscriber_iter->second;
+  if (!inserted) return subscriber;
+
+  subscriber.object_id = searcher().getId(object);
+  subscriber.object_ptr = object;
+  subscriber.observer = PropertyObserverPool::acquire(object);
+  subscriber.on_action_reported = connect(
+    subscriber.observer.get(), &PropertyObserver::actionReported, this,
+    [this, object_id = subscriber.object_id](const auto &action) {
+      reportChange(object_id, action);
+    });
+  subscriber.on_destroyed = connect(
+    object, &QObject::destroyed, this,
+    [this, object]() { unsubscribe(object); });
+
+  return subscriber;
+}
+
+void PropertySubscription::unsubscribe(QObject *object) {
+  auto subscriber = m_subscribers.find(object);
+  if (subscriber == m_subscribers.end()) return;
+
+  disconnect(subscriber->second.on_action_reported);
+  disconnect(subscriber->second.on_destroyed);
+  m_subscribers.erase(subscriber);
+}
+
+void PropertySubscription::unsubscribeUnused() {
+  auto unused_objects = QObjectList{};
+  for (const auto &[object, subscriber] : m_subscribers) {
+    if (!subscriber.explicit_object && subscriber.queries.empty()) {
+      unused_objects.push_back(object);
+    }
+  }
+
+  for (auto object : unused_objects) { unsubscribe(object); }
+}
+
+void PropertySubscription::resolveQueries() {
+  if (m_queries.empty()) return;
+
+  if (m_pending_objects.empty()) {
+    if (
+      m_last_resolution.isValid() &&
+      m_last_resolution.elapsed() < query_resolve_interval_ms) {
+      return;
+    }
+
+    m_last_resolution.start();
+    for (auto top_widget : getTopLevelObjects()) {
+      m_pending_objects.emplace_back(top_widget);
+    }
+  }
+
+  auto slice = TimeSlice(scheduler().getRemainingFrameBudget());
+  while (!m_pending_objects.empty() && !slice.expired()) {
+    const auto object = m_pending_objects.front().data();
+    m_pending_objects.pop_front();
+
+    if (!object) continue;
+
+    for (const auto &[key, query] : m_queries) {
+      if (!searcher().matchesQuery(object, query)) continue;
+
+      auto &query_match = m_query_matches[object];
+      query_match.object_ptr = object;
+      query_match.queries.insert(key);
+    }
+
+    for (const auto child : object->children()) {
+      m_pending_objects.emplace_back(child);
+    }
+  }
+
+  if (m_pending_objects.empty()) finishQueryResolution();
+}
+
+void PropertySubscription::restartQueryResolution() {
+  m_pending_objects.clear();
+  m_query_matches.clear();
+  m_last_resolution.invalidate();
+
+  resolveQueries();
+}
+
+void PropertySubscription::finishQueryResolution() {
+  for (auto &[object, subscriber] : m_subscribers) {
+    subscriber.queries.clear();
+  }
+
+  const auto query_matches = std::exchange(m_query_matches, {});
+  for (const auto &[object, query_match] : query_matches) {
+    if (!query_match.object_ptr) continue;
+    subscribe(object).queries = query_match.queries;
+  }
+
+  unsubscribeUnused();
+}
+
+void PropertySubscription::reportChange(
+  const ObjectId &object_id, PropertyObservedAction action) {
+  const auto key = qMakePair(object_id.toNumber(), action.getProperty());
+  const auto pending_update = m_pending_updates.constFind(key);
+  if (pending_update != m_pending_updates.constEnd()) {
+    if (m_changes[*pending_update].action.coalesce(action)) return;
+    m_pending_updates.erase(pending_update);
+  }
+
+  const auto first_change = m_changes.empty();
+  m_changes.append(ObjectChange{object_id, std::move(action)});
+
+  if (m_changes.last().action.is<PropertyObservedAction::PropertyUpdated>()) {
+    m_pending_updates.insert(key, m_changes.size() - 1);
+  }
+
+  if (first_change) Q_EMIT changesReported();
+}
+
+}// namespace specter
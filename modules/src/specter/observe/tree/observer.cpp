@@ -2,22 +2,31 @@
 #include "specter/observe/tree/observer.h"
 
 #include "specter/module.h"
+#include "specter/reflect/cache.h"
 #include "specter/search/utils.h"
 /* ------------------------------------ Qt ---------------------------------- */
 #include <QApplication>
+#include <QChildEvent>
 /* --------------------------------- Standard ------------------------------- */
+#include <algorithm>
 #include <set>
 /* -------------------------------------------------------------------------- */
 
+namespace {
+
+const auto event_driven_properties = QSet<QString>{"visible", "enabled"};
+
+}// namespace
+
 namespace specter {
 
 /* -------------------------------- TreeObserver ---------------------------- */
 
+const int TreeObserver::full_scan_interval = 100;
+
 TreeObserver::TreeObserver()
-    : m_observing(false), m_check_timer(new QTimer(this)) {
-  m_check_timer->setInterval(100);
-  connect(m_check_timer, &QTimer::timeout, this, &TreeObserver::intervalCheck);
-}
+    : m_observing(false), m_check_task(0), m_full_scan(false),
+      m_ticks_since_full_scan(0) {}
 
 TreeObserver::~TreeObserver() { stop(); }
 
@@ -37,11 +46,15 @@ void TreeObserver::stop() {
 
 bool TreeObserver::isObserving() const { return m_observing; }
 
-void TreeObserver::startIntervalCheck() { m_check_timer->start(); }
+void TreeObserver::startIntervalCheck() {
+  m_check_task = scheduler().addPeriodicTask(
+    TaskPriority::Stream, std::chrono::milliseconds(100),
+    [this]() { intervalCheck(); });
+}
 
 void TreeObserver::stopIntervalCheck() {
-  m_check_timer->stop();
-  m_tracked_objects.clear();
+  scheduler().removePeriodicTask(m_check_task);
+  untrackObjects();
 }
 
 void TreeObserver::intervalCheck() {
@@ -52,69 +65,116 @@ void TreeObserver::intervalCheck() {
 }
 
 void TreeObserver::checkForCreatedObjects() {
-  std::queue<QObject *> objects;
-  for (auto top_widget : getTopLevelObjects()) { objects.push(top_widget); }
+  const auto top_objects = getTopLevelObjects();
+
+  if (
+    m_scan_queue.empty() &&
+    ++m_ticks_since_full_scan >= full_scan_interval) {
+    m_ticks_since_full_scan = 0;
+    m_full_scan = true;
+    for (auto top_object : top_objects) {
+      m_scan_queue.emplace_back(top_object);
+    }
+  } else {
+    for (auto top_object : top_objects) {
+      if (!isTracked(top_object)) m_scan_queue.emplace_back(top_object);
+    }
+  }
+
+  auto top_widgets_changed = false;
+  auto slice = TimeSlice(scheduler().getRemainingFrameBudget());
 
-  while (!objects.empty()) {
-    auto object = objects.front();
-    objects.pop();
+  while (!m_scan_queue.empty() && !slice.expired()) {
+    auto object = m_scan_queue.front().data();
+    m_scan_queue.pop_front();
+
+    if (!object) continue;
 
     if (!m_tracked_objects.contains(object)) {
+      auto parent = object->parent();
+      auto tracked_parent = m_tracked_objects.find(parent);
+      if (parent && tracked_parent == m_tracked_objects.end()) continue;
+
       auto object_id = searcher().getId(object);
       auto object_query = searcher().getQuery(object);
-      auto parent = object->parent();
-      auto parent_id =
-        parent ? m_tracked_objects.at(parent).object_id : ObjectId{};
+      auto parent_id = parent ? tracked_parent->second.object_id : ObjectId{};
 
       m_tracked_objects.insert(
         std::make_pair(
           object, TrackedObjectCache{object_id, object_query, object, parent}));
+      trackObject(object);
+
+      if (!parent) top_widgets_changed = true;
 
       Q_EMIT actionReported(
         TreeObservedAction::ObjectAdded{object_id, parent_id});
       Q_EMIT actionReported(
         TreeObservedAction::ObjectRenamed{object_id, object_query});
+    } else if (m_full_scan) {
+      m_reparented_objects.insert(object);
+    } else {
+      continue;
     }
 
-    for (const auto child : object->children()) { objects.push(child); }
+    for (const auto child : object->children()) {
+      m_scan_queue.emplace_back(child);
+    }
+  }
+
+  if (m_scan_queue.empty()) m_full_scan = false;
+
+  if (top_widgets_changed) {
+    for (auto top_widget : top_objects) { markDirty(top_widget); }
   }
 }
 
 void TreeObserver::checkForDestroyedObjects() {
-  auto toRemove = [this](auto object) {
-    auto parents = std::queue<QObject *>{};
-    parents.push(object);
+  if (m_destroyed_objects.empty()) return;
+
+  auto objects = QList<std::pair<int, QObject *>>{};
+  for (auto object : std::exchange(m_destroyed_objects, {})) {
+    objects.append(std::make_pair(getTrackedDepth(object), object));
+  }
 
-    while (!parents.empty()) {
-      auto parent = parents.front();
-      parents.pop();
+  std::sort(objects.begin(), objects.end(), [](const auto &a, const auto &b) {
+    return a.first > b.first;
+  });
 
-      const auto &cache = m_tracked_objects.at(parent);
-      if (!cache.object_ptr) return true;
-      if (cache.parent) parents.push(cache.parent);
-    }
+  auto top_widgets_changed = false;
 
-    return false;
-  };
+  for (const auto &[depth, object] : objects) {
+    const auto cache_iter = m_tracked_objects.find(object);
+    if (cache_iter == m_tracked_objects.end()) continue;
 
-  auto objects = getTrackedObjectsInDFSOrder();
-  for (auto object : objects) {
-    if (toRemove(object)) {
-      const auto &cache = m_tracked_objects.at(object);
-      const auto &object_id = cache.object_id;
+    const auto &cache = cache_iter->second;
+    if (cache.object_ptr) continue;
 
-      Q_EMIT actionReported(TreeObservedAction::ObjectRemoved{object_id});
-      m_tracked_objects.erase(object);
-    }
+    if (!cache.parent) top_widgets_changed = true;
+
+    Q_EMIT actionReported(TreeObservedAction::ObjectRemoved{cache.object_id});
+    m_dirty_objects.remove(object);
+    m_polled_objects.remove(object);
+    m_reparented_objects.remove(object);
+    m_tracked_objects.erase(cache_iter);
+  }
+
+  if (top_widgets_changed) {
+    for (auto top_widget : getTopLevelObjects()) { markDirty(top_widget); }
   }
 }
 
 void TreeObserver::checkForRenamedObjects() {
-  auto objects = getTrackedObjectsInDFSOrder();
-  for (auto object : objects) {
-    auto &cache = m_tracked_objects.at(object);
-    const auto current_query = searcher().getQuery(object);
+  checkForPolledProperties();
+
+  const auto dirty_objects = std::exchange(m_dirty_objects, {});
+  for (auto object : dirty_objects) {
+    auto cache_iter = m_tracked_objects.find(object);
+    if (cache_iter == m_tracked_objects.end()) continue;
 
+    auto &cache = cache_iter->second;
+    if (!cache.object_ptr) continue;
+
+    const auto current_query = searcher().getQuery(object);
     if (cache.object_query != current_query) {
       Q_EMIT actionReported(
         TreeObservedAction::ObjectRenamed{cache.object_id, current_query});
@@ -124,82 +184,173 @@ void TreeObserver::checkForRenamedObjects() {
 }
 
 void TreeObserver::checkForReparentedObjects() {
-  auto objects = getTrackedObjectsInDFSOrder();
-  for (auto object : objects) {
-    auto &cache = m_tracked_objects.at(object);
-    if (!cache.object_ptr) continue;
+  if (m_reparented_objects.empty()) return;
 
-    const auto &object_id = cache.object_id;
-    const auto current_parent = object->parent();
+  for (auto object : std::exchange(m_reparented_objects, {})) {
+    auto cache_iter = m_tracked_objects.find(object);
+    if (cache_iter == m_tracked_objects.end()) continue;
 
-    auto opt_action = std::optional<TreeObservedAction::ObjectReparented>{};
+    auto &cache = cache_iter->second;
+    if (!cache.object_ptr) continue;
 
-    if (cache.parent != current_parent) {
-      opt_action = TreeObservedAction::ObjectReparented{
-        object_id, current_parent
-                     ? m_tracked_objects.at(current_parent).object_id
-                     : ObjectId{}};
-      cache.parent = current_parent;
+    const auto current_parent = object->parent();
+    if (cache.parent == current_parent) continue;
+
+    auto parent_id = ObjectId{};
+    if (current_parent) {
+      const auto tracked_parent = m_tracked_objects.find(current_parent);
+      if (tracked_parent == m_tracked_objects.end()) {
+        m_reparented_objects.insert(object);
+        continue;
+      }
+      parent_id = tracked_parent->second.object_id;
     }
 
-    if (opt_action) Q_EMIT actionReported(*opt_action);
+    cache.parent = current_parent;
+    Q_EMIT actionReported(
+      TreeObservedAction::ObjectReparented{cache.object_id, parent_id});
   }
 }
 
-QList<QObject *> TreeObserver::getTrackedObjectsInDFSOrder() const {
-  QList<QObject *> result = {};
-  QSet<QObject *> visited = {};
+void TreeObserver::checkForPolledProperties() {
+  for (auto object : m_polled_objects) {
+    auto cache_iter = m_tracked_objects.find(object);
+    if (cache_iter == m_tracked_objects.end()) continue;
 
-  QSet<QObject *> allActiveTrackedObjects = {};
-  QMap<QObject *, QObject *> objectToParentMap = {};
-  QMap<QObject *, QList<QObject *>> childrenOf = {};
-
-  for (const auto &pair : m_tracked_objects) {
-    auto currentObjectKey = pair.first;
-    const auto &cache = pair.second;
+    auto &cache = cache_iter->second;
+    if (!cache.object_ptr) continue;
 
-    allActiveTrackedObjects.insert(currentObjectKey);
-    objectToParentMap[currentObjectKey] = cache.parent;
+    for (auto i = 0; i < cache.polled_properties.size(); ++i) {
+      auto value = cache.polled_properties[i].read(object);
+      if (value != cache.polled_values[i]) {
+        cache.polled_values[i] = std::move(value);
+        m_dirty_objects.insert(object);
+      }
+    }
   }
+}
 
-  for (auto currentObject : allActiveTrackedObjects) {
-    auto parent = objectToParentMap.value(currentObject, nullptr);
-
-    if (parent != nullptr && allActiveTrackedObjects.contains(parent)) {
-      childrenOf[parent].append(currentObject);
+void TreeObserver::trackObject(QObject *object) {
+  static const auto on_query_property_changed =
+    TreeObserver::staticMetaObject.method(
+      TreeObserver::staticMetaObject.indexOfSlot("onQueryPropertyChanged()"));
+
+  object->installEventFilter(this);
+  connect(object, &QObject::objectNameChanged, this, [this, object]() {
+    markDirty(object, true);
+  });
+  connect(object, &QObject::destroyed, this, [this, object]() {
+    m_destroyed_objects.insert(object);
+  });
+
+  auto &cache = m_tracked_objects.at(object);
+  const auto &reflection = ReflectionCache::get(object->metaObject());
+  const auto properties = searcher().getQueryDependentProperties(object);
+  for (const auto &property_name : properties) {
+    if (property_name == QLatin1String("objectName")) continue;
+
+    const auto descriptor = reflection.getProperty(property_name.toUtf8());
+    if (!descriptor) continue;
+
+    const auto &property = descriptor->property;
+    if (property.hasNotifySignal()) {
+      connect(object, property.notifySignal(), this, on_query_property_changed);
+    } else if (
+      !object->isWidgetType() ||
+      !event_driven_properties.contains(property_name)) {
+      cache.polled_properties.append(property);
+      cache.polled_values.append(property.read(object));
     }
   }
 
-  QList<QObject *> roots = {};
-  for (auto obj : allActiveTrackedObjects) {
-    auto parent = objectToParentMap.value(obj, nullptr);
+  if (!cache.polled_properties.empty()) m_polled_objects.insert(object);
+}
 
-    if (parent == nullptr || !allActiveTrackedObjects.contains(parent)) {
-      roots.append(obj);
-    }
+void TreeObserver::untrackObjects() {
+  for (const auto &[object, cache] : m_tracked_objects) {
+    if (!cache.object_ptr) continue;
+
+    object->removeEventFilter(this);
+    disconnect(object, nullptr, this, nullptr);
   }
 
+  m_tracked_objects.clear();
+  m_dirty_objects.clear();
+  m_polled_objects.clear();
+  m_destroyed_objects.clear();
+  m_reparented_objects.clear();
+  m_scan_queue.clear();
+  m_full_scan = false;
+  m_ticks_since_full_scan = 0;
+}
+
+void TreeObserver::markDirty(QObject *object, bool recursive) {
+  if (m_tracked_objects.contains(object)) m_dirty_objects.insert(object);
+  if (!recursive) return;
 
-  std::function<void(QObject *)> dfs_post_order = [&](auto currentObject) {
-    if (
-      !allActiveTrackedObjects.contains(currentObject) ||
-      visited.contains(currentObject)) {
-      return;
-    }
-    visited.insert(currentObject);
+  for (const auto child : object->children()) { markDirty(child, true); }
+}
 
-    if (childrenOf.contains(currentObject)) {
-      for (auto child : childrenOf.value(currentObject)) {
-        dfs_post_order(child);
-      }
+void TreeObserver::markChildrenDirty(QObject *object) {
+  for (const auto child : object->children()) { markDirty(child); }
+}
+
+void TreeObserver::markReparented(QObject *object) {
+  if (m_tracked_objects.contains(object)) m_reparented_objects.insert(object);
+}
+
+bool TreeObserver::eventFilter(QObject *object, QEvent *event) {
+  switch (event->type()) {
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::EnabledChange:
+    case QEvent::DynamicPropertyChange:
+      markDirty(object);
+      break;
+
+    case QEvent::ParentChange:
+      markDirty(object, true);
+      markReparented(object);
+      break;
+
+    case QEvent::ChildAdded: {
+      const auto child = static_cast<QChildEvent *>(event)->child();
+      markChildrenDirty(object);
+      markDirty(child, true);
+
+      if (isTracked(child)) markReparented(child);
+      else m_scan_queue.emplace_back(child);
+      break;
     }
 
-    result.append(currentObject);
-  };
+    case QEvent::ChildRemoved:
+      markChildrenDirty(object);
+      markReparented(static_cast<QChildEvent *>(event)->child());
+      break;
 
-  for (auto root : roots) { dfs_post_order(root); }
+    default:
+      break;
+  }
+
+  return QObject::eventFilter(object, event);
+}
+
+void TreeObserver::onQueryPropertyChanged() { markDirty(sender()); }
+
+bool TreeObserver::isTracked(QObject *object) const {
+  const auto cache = m_tracked_objects.find(object);
+  return cache != m_tracked_objects.end() && cache->second.object_ptr == object;
+}
+
+int TreeObserver::getTrackedDepth(QObject *object) const {
+  auto depth = 0;
+  for (auto cache = m_tracked_objects.find(object);
+       cache != m_tracked_objects.end() && cache->second.parent;
+       cache = m_tracked_objects.find(cache->second.parent)) {
+    ++depth;
+  }
 
-  return result;
+  return depth;
 }
 
 /* ------------------------------ TreeObserverQueue ------------------------- */
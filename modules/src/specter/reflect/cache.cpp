@@ -0,0 +1,119 @@
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/reflect/cache.h"
+/* --------------------------------- Standard ------------------------------- */
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* ------------------------------- ClassReflection -------------------------- */
+
+ClassReflection::ClassReflection(const QMetaObject *meta_object)
+    : m_meta_object(meta_object) {
+  collectProperties();
+  collectMethods();
+}
+
+ClassReflection::~ClassReflection() = default;
+
+const QMetaObject *ClassReflection::getMetaObject() const {
+  return m_meta_object;
+}
+
+const QList<PropertyDescriptor> &ClassReflection::getProperties() const {
+  return m_properties;
+}
+
+const PropertyDescriptor *
+ClassReflection::getProperty(const QByteArray &name) const {
+  const auto position = m_property_positions.constFind(name);
+  return position != m_property_positions.constEnd()
+           ? &m_properties[*position]
+           : nullptr;
+}
+
+const QList<MethodDescriptor> &ClassReflection::getMethods() const {
+  return m_methods;
+}
+
+QList<const MethodDescriptor *>
+ClassReflection::getOverloads(const QByteArray &name, qsizetype arity) const {
+  auto overloads = QList<const MethodDescriptor *>{};
+  for (const auto position : m_overloads.value({name, arity})) {
+    overloads.append(&m_methods[position]);
+  }
+
+  return overloads;
+}
+
+void ClassReflection::collectProperties() {
+  auto unique_properties = std::map<QString, int>{};
+  for (auto i = 0; i < m_meta_object->propertyCount(); ++i) {
+    unique_properties[m_meta_object->property(i).name()] = i;
+  }
+
+  m_properties.reserve(unique_properties.size());
+  for (const auto &[name, property_index] : unique_properties) {
+    const auto property = m_meta_object->property(property_index);
+    m_property_positions.insert(property.name(), m_properties.size());
+    m_properties.append(PropertyDescriptor{
+      property_index, name, property.metaType(), property.isReadable(),
+      property.isWritable(), property});
+  }
+}
+
+void ClassReflection::collectMethods() {
+  m_methods.reserve(m_meta_object->methodCount());
+  for (auto i = 0; i < m_meta_object->methodCount(); ++i) {
+    const auto method = m_meta_object->method(i);
+
+    auto listed = method.access() == QMetaMethod::Access::Public &&
+                  (method.methodType() == QMetaMethod::Slot ||
+                   method.methodType() == QMetaMethod::Method);
+
+    auto parameter_names = method.parameterNames();
+    auto parameter_types = QList<QMetaType>{};
+    auto default_values = QVariantList{};
+    for (auto j = 0; j < method.parameterCount(); ++j) {
+      if (parameter_names[j].isEmpty()) {
+        parameter_names[j] = QByteArray("arg") + QByteArray::number(j);
+      }
+
+      const auto parameter_type = method.parameterMetaType(j);
+      const auto default_value = QVariant(parameter_type);
+      if (!default_value.isValid()) listed = false;
+
+      parameter_types.append(parameter_type);
+      default_values.append(default_value);
+    }
+
+    m_overloads[{method.name(), method.parameterCount()}].append(
+      m_methods.size());
+    m_methods.append(MethodDescriptor{
+      i, method.name(), parameter_names, parameter_types, default_values,
+      listed, method});
+  }
+}
+
+/* ------------------------------- ReflectionCache -------------------------- */
+
+const ClassReflection &
+ReflectionCache::get(const QMetaObject *meta_object) {
+  using ReflectionKey = std::pair<const QMetaObject *, QByteArray>;
+
+  static std::mutex mutex;
+  static auto reflections =
+    std::map<ReflectionKey, std::unique_ptr<ClassReflection>>{};
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto &reflection =
+    reflections[ReflectionKey{meta_object, meta_object->className()}];
+  if (!reflection) reflection = std::make_unique<ClassReflection>(meta_object);
+
+  return *reflection;
+}
+
+}// namespace specter
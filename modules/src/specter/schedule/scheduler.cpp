@@ -0,0 +1,173 @@
+/* ----------------------------------- Local -------------------------------- */
+#include "specter/schedule/scheduler.h"
+/* -------------------------------------------------------------------------- */
+
+namespace specter {
+
+/* --------------------------------- Scheduler ------------------------------ */
+
+const int Scheduler::tick_interval_ms = 10;
+const int Scheduler::max_coarsening = 8;
+const std::chrono::microseconds Scheduler::min_frame_budget =
+  std::chrono::microseconds(500);
+
+Scheduler::Scheduler()
+    : m_tick_timer(new QTimer(this)), m_last_tick_ms(0),
+      m_frame_budget(std::chrono::milliseconds(4)), m_host_busy(false),
+      m_budget_overruns(0), m_next_task_id(1) {
+  m_clock.start();
+
+  m_tick_timer->setInterval(tick_interval_ms);
+  connect(m_tick_timer, &QTimer::timeout, this, &Scheduler::tick);
+  m_tick_timer->start();
+}
+
+Scheduler::~Scheduler() = default;
+
+Scheduler::TaskId Scheduler::addPeriodicTask(
+  TaskPriority priority, std::chrono::milliseconds interval, Task task) {
+  const auto id = m_next_task_id++;
+  m_periodic_tasks.emplace(
+    id, PeriodicTask{
+          priority, interval, std::move(task),
+          m_clock.elapsed() + interval.count()});
+
+  return id;
+}
+
+void Scheduler::removePeriodicTask(TaskId id) { m_periodic_tasks.erase(id); }
+
+void Scheduler::post(TaskPriority priority, Task task) {
+  m_queues[static_cast<std::size_t>(priority)].push_back(std::move(task));
+}
+
+void Scheduler::setFrameBudget(std::chrono::microseconds budget) {
+  m_frame_budget = std::max(budget, min_frame_budget);
+}
+
+std::chrono::microseconds Scheduler::getFrameBudget() const {
+  return m_frame_budget;
+}
+
+std::chrono::microseconds Scheduler::getRemainingFrameBudget() const {
+  if (!m_frame.isValid()) return m_frame_budget;
+
+  const auto spent = std::chrono::microseconds(m_frame.nsecsElapsed() / 1000);
+  return std::max(m_frame_budget - spent, std::chrono::microseconds(0));
+}
+
+bool Scheduler::isHostBusy() const { return m_host_busy; }
+
+quint64 Scheduler::getBudgetOverruns() const { return m_budget_overruns; }
+
+void Scheduler::tick() {
+  const auto now_ms = m_clock.elapsed();
+  const auto lag_ms = now_ms - m_last_tick_ms - tick_interval_ms;
+  m_last_tick_ms = now_ms;
+
+  const auto budget_us = qint64(m_frame_budget.count());
+  m_host_busy = lag_ms * 1000 > budget_us;
+
+  schedulePeriodicTasks(now_ms);
+
+  m_frame.start();
+
+  for (auto priority = std::size_t{0}; priority < m_queues.size();
+       ++priority) {
+    const auto deferrable =
+      priority != static_cast<std::size_t>(TaskPriority::Input);
+
+    auto &queue = m_queues[priority];
+    auto ran_task = false;
+    while (!queue.empty()) {
+      const auto over_budget = m_frame.nsecsElapsed() / 1000 >= budget_us;
+      if (deferrable && ran_task && over_budget) break;
+
+      auto task = std::move(queue.front());
+      queue.pop_front();
+      task();
+      ran_task = true;
+    }
+  }
+
+  const auto spent_us = m_frame.nsecsElapsed() / 1000;
+  m_frame.invalidate();
+
+  if (spent_us > budget_us) {
+    ++m_budget_overruns;
+    Q_EMIT budgetExceeded(spent_us, budget_us);
+  }
+}
+
+void Scheduler::schedulePeriodicTasks(qint64 now_ms) {
+  for (auto &[id, periodic_task] : m_periodic_tasks) {
+    if (periodic_task.pending || now_ms < periodic_task.next_run_ms) continue;
+
+    if (periodic_task.priority >= TaskPriority::Stream) {
+      periodic_task.coarsening =
+        m_host_busy ? std::min(periodic_task.coarsening * 2, max_coarsening)
+                    : std::max(periodic_task.coarsening / 2, 1);
+    }
+
+    periodic_task.pending = true;
+    periodic_task.next_run_ms =
+      now_ms + periodic_task.interval.count() * periodic_task.coarsening;
+
+    post(periodic_task.priority, [this, id]() { runPeriodicTask(id); });
+  }
+}
+
+void Scheduler::runPeriodicTask(TaskId id) {
+  auto periodic_task = m_periodic_tasks.find(id);
+  if (periodic_task == m_periodic_tasks.end()) return;
+
+  periodic_task->second.pending = false;
+
+  const auto task = periodic_task->second.task;
+  task();
+}
+
+/* --------------------------------- TimeSlice ------------------------------ */
+
+const int TimeSlice::check_interval = 64;
+
+TimeSlice::TimeSlice(std::chrono::microseconds duration)
+    : m_duration_ns(duration.count() * 1000), m_steps(0) {
+  m_timer.start();
+}
+
+TimeSlice::~TimeSlice() = default;
+
+bool TimeSlice::expired() {
+  if (++m_steps % check_interval != 0) return false;
+  return m_timer.nsecsElapsed() >= m_duration_ns;
+}
+
+/* -------------------------------- RateLimiter ----------------------------- */
+
+RateLimiter::RateLimiter(uint max_rate) : m_max_rate(max_rate) {}
+
+RateLimiter::~RateLimiter() = default;
+
+void RateLimiter::setMaxRate(uint max_rate) { m_max_rate = max_rate; }
+
+uint RateLimiter::getMaxRate() const { return m_max_rate; }
+
+bool RateLimiter::isReady() const {
+  return getDelay() == std::chrono::milliseconds(0);
+}
+
+std::chrono::milliseconds RateLimiter::getDelay() const {
+  if (m_max_rate == 0 || !m_last_consumed.isValid()) {
+    return std::chrono::milliseconds(0);
+  }
+
+  const auto interval_ms = qint64(1000 / m_max_rate);
+  const auto elapsed_ms = m_last_consumed.elapsed();
+  return std::chrono::milliseconds(
+    std::max(interval_ms - elapsed_ms, qint64{0}));
+}
+
+void RateLimiter::consume() { m_last_consumed.start(); }
+
+}// namespace specter
@@ -25,6 +25,8 @@ ObjectId ObjectId::fromString(const QString &id) {
 
 QString ObjectId::toString() const { return QString::number(m_data); }
 
+qulonglong ObjectId::toNumber() const { return m_data; }
+
 bool ObjectId::operator==(const ObjectId &other) const {
   return m_data == other.m_data;
 }
@@ -4,6 +4,7 @@
 #include "specter/search/utils.h"
 /* ------------------------------------ Qt ---------------------------------- */
 #include <QApplication>
+#include <QHash>
 #include <QWidget>
 /* --------------------------------- Standard ------------------------------- */
 #include <queue>
@@ -46,6 +47,33 @@ QList<QObject *> Searcher::getObjects(const ObjectQuery &query) const {
   return objects;
 }
 
+QList<QObject *> Searcher::getObjects(const QList<ObjectId> &ids) const {
+  auto found_objects = QList<QObject *>(ids.size(), nullptr);
+
+  auto pending_ids = QHash<qulonglong, QList<qsizetype>>{};
+  for (auto i = 0; i < ids.size(); ++i) {
+    pending_ids[ids[i].toNumber()].append(i);
+  }
+
+  const auto top_widgets = getTopLevelObjects();
+  auto objects = std::queue<QObject *>{};
+  for (auto top_widget : top_widgets) {
+    if (!top_widget->parent()) objects.push(top_widget);
+  }
+
+  while (!objects.empty() && !pending_ids.empty()) {
+    auto object = objects.front();
+    objects.pop();
+
+    const auto positions = pending_ids.take(getId(object).toNumber());
+    for (const auto position : positions) { found_objects[position] = object; }
+
+    for (const auto &child : object->children()) { objects.push(child); }
+  }
+
+  return found_objects;
+}
+
 ObjectQuery Searcher::getQuery(const QObject *object) const {
   return getQueryFiltered(object, {});
 }
@@ -83,10 +111,31 @@ ObjectId Searcher::getId(const QObject *object) const {
   return ObjectId(object);
 }
 
+QSet<QString>
+Searcher::getQueryDependentProperties(const QObject *object) const {
+  if (!object) return {};
+
+  auto properties = QSet<QString>{};
+  for (const auto &search_strategy : m_strategies) {
+    properties.unite(search_strategy->queryDependentProperties(object));
+  }
+
+  return properties;
+}
+
 void Searcher::addStrategy(std::unique_ptr<SearchStrategy> &&strategy) {
   m_strategies.emplace_back(std::move(strategy));
 }
 
+bool Searcher::matchesQuery(
+  const QObject *object, const ObjectQuery &query) const {
+  return std::all_of(
+    m_strategies.begin(), m_strategies.end(),
+    [object, &query](const auto &search_strategy) {
+      return search_strategy->matchesObjectQuery(object, query.m_data);
+    });
+}
+
 QList<QObject *>
 Searcher::findObjects(const ObjectQuery &query, qsizetype limit) const {
   const auto top_widgets = getTopLevelObjects();
@@ -100,13 +149,7 @@ Searcher::findObjects(const ObjectQuery &query, qsizetype limit) const {
     auto object = objects.front();
     objects.pop();
 
-    const auto matches_query = std::all_of(
-      m_strategies.begin(), m_strategies.end(),
-      [object, &query](const auto &search_strategy) {
-        return search_strategy->matchesObjectQuery(object, query.m_data);
-      });
-
-    if (matches_query) { found_objects.push_back(object); }
+    if (matchesQuery(object, query)) { found_objects.push_back(object); }
 
     for (const auto &child : object->children()) { objects.push(child); }
   }
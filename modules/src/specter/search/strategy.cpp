@@ -48,6 +48,12 @@ SearchStrategy::~SearchStrategy() = default;
 
 SearchStrategy::Kind SearchStrategy::kind() const { return m_kind; }
 
+QSet<QString>
+SearchStrategy::queryDependentProperties(const QObject *object) const {
+  Q_UNUSED(object);
+  return {};
+}
+
 /* -------------------------------- TypeSearch ------------------------------ */
 
 TypeSearch::TypeSearch() : SearchStrategy(Kind::Type) {}
@@ -109,6 +115,11 @@ QVariantMap PropertiesSearch::createObjectQuery(const QObject *object) const {
   return query;
 }
 
+QSet<QString>
+PropertiesSearch::queryDependentProperties(const QObject *object) const {
+  return getUsedProperties(object);
+}
+
 QSet<QString> PropertiesSearch::getUsedProperties(const QObject *object) {
   static const auto type_to_properties = getTypeToProperties();
 
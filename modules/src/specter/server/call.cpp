@@ -6,8 +6,10 @@ namespace specter {
 
 /* ---------------------------------- Callable ------------------------------ */
 
-Callable::Callable() = default;
+Callable::Callable(TaskPriority priority) : m_priority(priority) {}
 
 Callable::~Callable() = default;
 
+TaskPriority Callable::getPriority() const { return m_priority; }
+
 }// namespace specter
@@ -17,9 +17,11 @@ namespace specter {
 const int Server::poll_batch_size = 10;
 const int Server::poll_interval_ms = 10;
 
-Server::Server() = default;
+Server::Server(Scheduler &scheduler)
+    : m_scheduler(scheduler), m_poll_task(0) {}
 
 Server::~Server() {
+  m_scheduler.removePeriodicTask(m_poll_task);
   m_server->Shutdown();
   m_queue->Shutdown();
 }
@@ -46,25 +48,27 @@ void Server::listen(const QHostAddress &host, quint16 port) {
 void Server::startLoop() {
   for (const auto &service : m_services) { service->start(m_queue.get()); }
 
-  QTimer *timer = new QTimer(this);
-  QObject::connect(timer, &QTimer::timeout, [timer, this]() {
-    void *tag = nullptr;
-    bool ok = false;
-
-    for (int i = 0; i < poll_batch_size; ++i) {
-      auto status =
-        m_queue->AsyncNext(&tag, &ok, std::chrono::system_clock::now());
-      if (status == grpc::CompletionQueue::GOT_EVENT) {
-        auto call_tag = static_cast<CallTag *>(tag);
-        auto callable = static_cast<Callable *>(call_tag->callable);
-        if (callable) callable->proceed(ok);
-      } else if (status != grpc::CompletionQueue::GOT_EVENT) {
-        return;
-      }
-    }
-  });
+  m_poll_task = m_scheduler.addPeriodicTask(
+    TaskPriority::Input, std::chrono::milliseconds(poll_interval_ms),
+    [this]() { poll(); });
+}
+
+void Server::poll() {
+  void *tag = nullptr;
+  bool ok = false;
 
-  timer->start(poll_interval_ms);
+  for (int i = 0; i < poll_batch_size; ++i) {
+    auto status =
+      m_queue->AsyncNext(&tag, &ok, std::chrono::system_clock::now());
+    if (status != grpc::CompletionQueue::GOT_EVENT) return;
+
+    auto call_tag = static_cast<CallTag *>(tag);
+    auto callable = static_cast<Callable *>(call_tag->callable);
+    if (callable) {
+      m_scheduler.post(
+        callable->getPriority(), [callable, ok]() { callable->proceed(ok); });
+    }
+  }
 }
 
 }// namespace specter
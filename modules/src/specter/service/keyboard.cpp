@@ -16,7 +16,8 @@ KeyboardPressKeyCall::KeyboardPressKeyCall(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::KeyboardService::AsyncService::RequestPressKey) {}
+        &specter_proto::KeyboardService::AsyncService::RequestPressKey,
+        TaskPriority::Input) {}
 
 KeyboardPressKeyCall::~KeyboardPressKeyCall() = default;
 
@@ -56,7 +57,8 @@ KeyboardReleaseKeyCall::KeyboardReleaseKeyCall(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::KeyboardService::AsyncService::RequestReleaseKey) {}
+        &specter_proto::KeyboardService::AsyncService::RequestReleaseKey,
+        TaskPriority::Input) {}
 
 KeyboardReleaseKeyCall::~KeyboardReleaseKeyCall() = default;
 
@@ -97,7 +99,8 @@ KeyboardTapKeyCall::KeyboardTapKeyCall(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::KeyboardService::AsyncService::RequestTapKey) {}
+        &specter_proto::KeyboardService::AsyncService::RequestTapKey,
+        TaskPriority::Input) {}
 
 KeyboardTapKeyCall::~KeyboardTapKeyCall() = default;
 
@@ -137,7 +140,8 @@ KeyboardEnterTextCall::KeyboardEnterTextCall(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::KeyboardService::AsyncService::RequestEnterText) {}
+        &specter_proto::KeyboardService::AsyncService::RequestEnterText,
+        TaskPriority::Input) {}
 
 KeyboardEnterTextCall::~KeyboardEnterTextCall() = default;
 
@@ -171,7 +175,8 @@ KeyboardEnterTextIntoObjectCall::KeyboardEnterTextIntoObjectCall(
     : CallData(
         service, queue, CallTag{this},
         &specter_proto::KeyboardService::AsyncService::
-          RequestEnterTextIntoObject) {}
+          RequestEnterTextIntoObject,
+        TaskPriority::Input) {}
 
 KeyboardEnterTextIntoObjectCall::~KeyboardEnterTextIntoObjectCall() = default;
 
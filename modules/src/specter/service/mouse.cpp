@@ -16,7 +16,8 @@ MousePressButtonCall::MousePressButtonCall(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::MouseService::AsyncService::RequestPressButton) {}
+        &specter_proto::MouseService::AsyncService::RequestPressButton,
+        TaskPriority::Input) {}
 
 MousePressButtonCall::~MousePressButtonCall() = default;
 
@@ -64,7 +65,8 @@ MouseReleaseButtonCall::MouseReleaseButtonCall(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::MouseService::AsyncService::RequestReleaseButton) {}
+        &specter_proto::MouseService::AsyncService::RequestReleaseButton,
+        TaskPriority::Input) {}
 
 MouseReleaseButtonCall::~MouseReleaseButtonCall() = default;
 
@@ -110,7 +112,8 @@ MouseClickButtonCall::MouseClickButtonCall(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::MouseService::AsyncService::RequestClickButton) {}
+        &specter_proto::MouseService::AsyncService::RequestClickButton,
+        TaskPriority::Input) {}
 
 MouseClickButtonCall::~MouseClickButtonCall() = default;
 
@@ -158,7 +161,8 @@ MouseMoveCursorCall::MouseMoveCursorCall(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::MouseService::AsyncService::RequestMoveCursor) {}
+        &specter_proto::MouseService::AsyncService::RequestMoveCursor,
+        TaskPriority::Input) {}
 
 MouseMoveCursorCall::~MouseMoveCursorCall() = default;
 
@@ -183,7 +187,8 @@ MouseScrollWheelCall::MouseScrollWheelCall(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::MouseService::AsyncService::RequestScrollWheel) {}
+        &specter_proto::MouseService::AsyncService::RequestScrollWheel,
+        TaskPriority::Input) {}
 
 MouseScrollWheelCall::~MouseScrollWheelCall() = default;
 
@@ -216,7 +221,8 @@ MouseClickOnObject::MouseClickOnObject(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::MouseService::AsyncService::RequestClickOnObject) {}
+        &specter_proto::MouseService::AsyncService::RequestClickOnObject,
+        TaskPriority::Input) {}
 
 MouseClickOnObject::~MouseClickOnObject() = default;
 
@@ -263,7 +269,8 @@ MouseHoverOverObjectCall::MouseHoverOverObjectCall(
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::MouseService::AsyncService::RequestHoverOverObject) {}
+        &specter_proto::MouseService::AsyncService::RequestHoverOverObject,
+        TaskPriority::Input) {}
 
 MouseHoverOverObjectCall::~MouseHoverOverObjectCall() = default;
 
@@ -3,18 +3,233 @@
 
 #include "specter/module.h"
 #include "specter/observe/property/action.h"
+#include "specter/observe/property/filter.h"
 #include "specter/observe/property/observer.h"
+#include "specter/observe/property/subscription.h"
 #include "specter/observe/tree/action.h"
 #include "specter/observe/tree/observer.h"
+#include "specter/reflect/cache.h"
 #include "specter/search/utils.h"
 #include "specter/service/utils.h"
 /* ------------------------------------ Qt ---------------------------------- */
 #include <QApplication>
+#include <QPointer>
 #include <QWidget>
 /* --------------------------------- Standard ------------------------------- */
-#include <queue>
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 /* -------------------------------------------------------------------------- */
 
+namespace {
+
+uint treeMaxDepth(const specter_proto::TreeRequest &request) {
+  return request.has_max_depth() ? request.max_depth()
+                                 : std::numeric_limits<uint>::max();
+}
+
+qsizetype treePageSize(const specter_proto::TreeRequest &request) {
+  return request.has_page_size() && request.page_size() > 0
+           ? qsizetype(request.page_size())
+           : std::numeric_limits<qsizetype>::max();
+}
+
+void readProperties(
+  const QObject *object, const specter::PropertyFilter &filter,
+  specter_proto::ValueEncoding encoding,
+  google::protobuf::RepeatedPtrField<specter_proto::Property> *properties) {
+  const auto meta_object = object->metaObject();
+  const auto property_indices = filter.getPropertyIndices(meta_object);
+  properties->Reserve(property_indices.size());
+
+  for (const auto property_index : property_indices) {
+    const auto meta_property = meta_object->property(property_index);
+    const auto value = meta_property.read(object);
+
+    auto property = properties->Add();
+    property->set_property_name(meta_property.name());
+    property->set_read_only(!meta_property.isWritable());
+
+    if (encoding == specter_proto::TYPED) {
+      *property->mutable_typed_value() =
+        specter::convertIntoSpecterValue(value);
+    } else {
+      *property->mutable_value() = specter::convertIntoValue(value);
+    }
+  }
+}
+
+template<typename Message> QVariant convertValueOf(const Message &message) {
+  return message.has_typed_value()
+           ? specter::convertIntoVariant(message.typed_value())
+           : specter::convertIntoVariant(message.value());
+}
+
+template<typename Message>
+QVariantList convertArgumentsOf(const Message &message) {
+  auto arguments = QVariantList{};
+  if (message.typed_arguments_size() > 0) {
+    for (const auto &argument : message.typed_arguments()) {
+      arguments.push_back(specter::convertIntoVariant(argument));
+    }
+  } else {
+    for (const auto &argument : message.arguments()) {
+      arguments.push_back(specter::convertIntoVariant(argument));
+    }
+  }
+
+  return arguments;
+}
+
+void setObjectStatus(
+  specter_proto::ObjectStatus *object_status, const QObject *object,
+  const grpc::Status &status) {
+  object_status->mutable_object_id()->set_id(
+    specter::searcher().getId(object).toString().toStdString());
+  object_status->set_code(status.error_code());
+  object_status->set_message(status.error_message());
+}
+
+QMetaMethod findMetaMethod(
+  const QObject *object, const std::string &name,
+  const QVariantList &parameters) {
+  const auto &reflection = specter::ReflectionCache::get(object->metaObject());
+  const auto overloads = reflection.getOverloads(
+    QByteArray::fromStdString(name), parameters.size());
+
+  for (const auto overload : overloads) {
+    auto convertible = true;
+    for (auto i = 0; i < parameters.size() && convertible; ++i) {
+      convertible = parameters[i].canConvert(overload->parameter_types[i]);
+    }
+
+    if (convertible) return overload->method;
+  }
+
+  return QMetaMethod{};
+}
+
+grpc::Status invokeMethod(
+  QObject *object, const std::string &method, QVariantList parameters) {
+  const auto meta_method = findMetaMethod(object, method, parameters);
+  if (!meta_method.isValid()) {
+    return grpc::Status(
+      grpc::StatusCode::INVALID_ARGUMENT,
+      QLatin1String("Method '%1' is unknown.")
+        .arg(method.c_str())
+        .toStdString());
+  }
+
+  for (auto i = 0; i < meta_method.parameterCount(); ++i) {
+    const auto parameter_meta_type = meta_method.parameterMetaType(i);
+    auto &parameter = parameters[i];
+
+    parameter.convert(parameter_meta_type);
+  }
+
+  const auto _generic_arg = [&parameters](auto index) {
+    return parameters.size() > index
+             ? QGenericArgument(
+                 parameters[index].typeName(), parameters[index].data())
+             : QGenericArgument{};
+  };
+
+  meta_method.invoke(
+    object, Qt::QueuedConnection, _generic_arg(0), _generic_arg(1),
+    _generic_arg(2), _generic_arg(3), _generic_arg(4), _generic_arg(5),
+    _generic_arg(6), _generic_arg(7), _generic_arg(8), _generic_arg(9));
+
+  return grpc::Status::OK;
+}
+
+struct PropertyWrite {
+  QPointer<QObject> object = nullptr;
+  QByteArray property_name = {};
+  const specter::PropertyDescriptor *descriptor = nullptr;
+  QVariant value = {};
+};
+
+std::pair<grpc::Status, PropertyWrite> preparePropertyWrite(
+  QObject *object, const std::string &property, QVariant new_value) {
+  const auto property_name = QByteArray::fromStdString(property);
+  const auto &reflection = specter::ReflectionCache::get(object->metaObject());
+  const auto descriptor = reflection.getProperty(property_name);
+
+  auto property_meta_type = descriptor
+                              ? descriptor->meta_type
+                              : object->property(property_name).metaType();
+
+  if (property_meta_type.id() == QMetaType::UnknownType) {
+    return {
+      grpc::Status(
+        grpc::StatusCode::INVALID_ARGUMENT,
+        QLatin1String("Property '%1' type is unknown.")
+          .arg(property_name)
+          .toStdString()),
+      {}};
+  }
+
+  const auto holds_variant = property_meta_type.id() == QMetaType::QVariant;
+  if (!holds_variant && !new_value.convert(property_meta_type)) {
+    return {
+      grpc::Status(
+        grpc::StatusCode::INVALID_ARGUMENT,
+        QLatin1String("Property '%1' value '%2' is incorrect.")
+          .arg(property_name)
+          .arg(new_value.toString())
+          .toStdString()),
+      {}};
+  }
+
+  if (descriptor) {
+    if (!descriptor->writable) {
+      QString error_msg =
+        QLatin1String("Property '%1' could not be set to '%2'. "
+                      "The property may not exist or is not writable.")
+          .arg(property_name, new_value.toString());
+      return {
+        grpc::Status(
+          grpc::StatusCode::INVALID_ARGUMENT, error_msg.toStdString()),
+        {}};
+    }
+  }
+
+  return {
+    grpc::Status::OK,
+    PropertyWrite{object, property_name, descriptor, std::move(new_value)}};
+}
+
+QVariant readProperty(const PropertyWrite &write) {
+  return write.descriptor ? write.descriptor->property.read(write.object)
+                          : write.object->property(write.property_name);
+}
+
+grpc::Status writeProperty(const PropertyWrite &write, const QVariant &value) {
+  if (!write.object) {
+    return grpc::Status(
+      grpc::StatusCode::NOT_FOUND, "There is not object for passed id");
+  }
+
+  auto ret = write.descriptor
+               ? write.descriptor->property.write(write.object, value)
+               : write.object->setProperty(write.property_name, value);
+  if (!ret) {
+    return grpc::Status(
+      grpc::StatusCode::INVALID_ARGUMENT,
+      QLatin1String("Property '%1' set failed.")
+        .arg(write.property_name)
+        .toStdString());
+  }
+
+  return grpc::Status::OK;
+}
+
+}// namespace
+
 namespace specter {
 
 /* --------------------------- TreeObservedActionsMapper ------------------------ */
@@ -68,13 +283,25 @@ public:
 
 class PropertyObservedActionsMapper {
 public:
+  explicit PropertyObservedActionsMapper()
+      : m_encoding(specter_proto::STRUCT) {}
+
+  void setEncoding(specter_proto::ValueEncoding encoding) {
+    m_encoding = encoding;
+  }
+
   specter_proto::PropertyChange
   operator()(const PropertyObservedAction::PropertyAdded &action) const {
     specter_proto::PropertyChange response;
     auto added = response.mutable_added();
     added->set_property_name(action.property.toStdString());
-    *added->mutable_value() = convertIntoValue(action.value);
     added->set_read_only(action.read_only);
+
+    if (m_encoding == specter_proto::TYPED) {
+      *added->mutable_typed_value() = convertIntoSpecterValue(action.value);
+    } else {
+      *added->mutable_value() = convertIntoValue(action.value);
+    }
     return response;
   }
 
@@ -91,20 +318,62 @@ public:
     specter_proto::PropertyChange response;
     auto updated = response.mutable_updated();
     updated->set_property_name(action.property.toStdString());
-    *updated->mutable_old_value() = convertIntoValue(action.old_value);
-    *updated->mutable_new_value() = convertIntoValue(action.new_value);
+    updated->set_skipped_updates(action.skipped_updates);
+
+    if (m_encoding == specter_proto::TYPED) {
+      *updated->mutable_typed_old_value() =
+        convertIntoSpecterValue(action.old_value);
+      *updated->mutable_typed_new_value() =
+        convertIntoSpecterValue(action.new_value);
+    } else {
+      *updated->mutable_old_value() = convertIntoValue(action.old_value);
+      *updated->mutable_new_value() = convertIntoValue(action.new_value);
+    }
     return response;
   }
+
+private:
+  specter_proto::ValueEncoding m_encoding;
 };
 
 /* ------------------------------ ObjectGetTreeCall -------------------------- */
 
+struct ObjectGetTreeCall::TreeWalk {
+  struct PendingNode {
+    QPointer<QObject> object;
+    const QMetaObject *meta_object;
+    qulonglong id;
+    specter_proto::ObjectNode *node;
+    int parent;
+    uint depth;
+  };
+
+  static PendingNode
+  nested(QObject *object, specter_proto::ObjectNode *node, uint depth) {
+    const auto object_id = searcher().getId(object);
+    node->mutable_object_id()->set_id(object_id.toString().toStdString());
+    return PendingNode{object, object->metaObject(), 0, node, -1, depth};
+  }
+
+  static PendingNode flat(QObject *object, int parent, uint depth) {
+    const auto id = searcher().getId(object).toNumber();
+    return PendingNode{
+      object, object->metaObject(), id, nullptr, parent, depth};
+  }
+
+  bool started = false;
+  Response response;
+  std::vector<PendingNode> pending;
+  std::unordered_map<const QMetaObject *, uint> class_names;
+};
+
 ObjectGetTreeCall::ObjectGetTreeCall(
   specter_proto::ObjectService::AsyncService *service,
   grpc::ServerCompletionQueue *queue)
-    : CallData(
+    : SlicedCallData(
         service, queue, CallTag{this},
-        &specter_proto::ObjectService::AsyncService::RequestGetTree) {}
+        &specter_proto::ObjectService::AsyncService::RequestGetTree),
+      m_walk(std::make_unique<TreeWalk>()) {}
 
 ObjectGetTreeCall::~ObjectGetTreeCall() = default;
 
@@ -114,59 +383,210 @@ std::unique_ptr<ObjectGetTreeCallData> ObjectGetTreeCall::clone() const {
 
 ObjectGetTreeCall::ProcessResult
 ObjectGetTreeCall::process(const Request &request) const {
-  auto objects = QObjectList{};
+  if (!m_walk->started) {
+    const auto status = start(request);
+    if (!status.ok()) return std::make_pair(status, Response{});
+  }
 
+  const auto done = request.encoding() == specter_proto::FLAT
+                      ? flatWalk(request)
+                      : walk(request);
+  if (!done) return {};
+
+  return std::make_pair(grpc::Status::OK, std::move(m_walk->response));
+}
+
+grpc::Status ObjectGetTreeCall::start(const Request &request) const {
+  m_walk->started = true;
+
+  auto parent = static_cast<QObject *>(nullptr);
   if (request.has_id()) {
     auto id = ObjectId::fromString(QString::fromStdString(request.id()));
     auto [status, object] = tryGetSingleObject(id);
-    if (!status.ok()) return {status, {}};
-    objects.append(object);
+    if (!status.ok()) return status;
+    parent = object;
+  }
+
+  auto roots = QObjectList{};
+  if (parent && !request.has_page_token()) {
+    roots.push_back(parent);
+  } else {
+    auto offset = qsizetype{0};
+    if (request.has_page_token()) {
+      auto valid_token = false;
+      offset =
+        QString::fromStdString(request.page_token()).toLongLong(&valid_token);
+      if (!valid_token || offset < 0) {
+        return grpc::Status(
+          grpc::StatusCode::INVALID_ARGUMENT, "Page token is incorrect");
+      }
+    }
+
+    const auto siblings = parent ? parent->children() : getTopLevelObjects();
+    const auto page_size = std::min(treePageSize(request), siblings.size());
+
+    roots = siblings.mid(offset, page_size);
+    if (offset + page_size < siblings.size()) {
+      m_walk->response.set_next_page_token(
+        QString::number(offset + page_size).toStdString());
+    }
+  }
+
+  if (request.encoding() == specter_proto::FLAT) {
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+      m_walk->pending.push_back(TreeWalk::flat(*it, -1, 0));
+    }
   } else {
-    objects.append(getTopLevelObjects());
+    for (const auto root : roots) {
+      m_walk->pending.push_back(
+        TreeWalk::nested(root, m_walk->response.add_roots(), 0));
+    }
   }
 
-  const auto response = tree(objects);
-  return {grpc::Status::OK, response};
+  return grpc::Status::OK;
 }
 
-ObjectGetTreeCall::Response
-ObjectGetTreeCall::tree(const QObjectList &objects) const {
-  auto response = ObjectGetTreeCall::Response{};
+bool ObjectGetTreeCall::walk(const Request &request) const {
+  const auto max_depth = treeMaxDepth(request);
+  const auto page_size = treePageSize(request);
+
+  auto &pending = m_walk->pending;
+  auto slice = TimeSlice(scheduler().getRemainingFrameBudget());
+  while (!pending.empty() && !slice.expired()) {
+    const auto pending_node = pending.back();
+    pending.pop_back();
+
+    const auto object = pending_node.object.data();
+    if (!object) continue;
+
+    const auto node = pending_node.node;
+    describe(object, node, request.fields());
+
+    const auto &children = object->children();
+    node->set_child_count(children.size());
+
+    const auto expanded_children =
+      pending_node.depth < max_depth ? std::min(page_size, children.size())
+                                     : 0;
+    for (auto i = 0; i < expanded_children; ++i) {
+      pending.push_back(TreeWalk::nested(
+        children[i], node->add_children(), pending_node.depth + 1));
+    }
 
-  auto objectsToProcess =
-    std::queue<std::pair<QObject *, specter_proto::ObjectNode *>>{};
-  for (const auto object : objects) {
-    objectsToProcess.push(std::make_pair(object, response.add_roots()));
+    if (expanded_children < children.size()) {
+      node->set_children_page_token(
+        QString::number(expanded_children).toStdString());
+    }
   }
 
-  while (!objectsToProcess.empty()) {
-    auto objectToProcess = objectsToProcess.front();
-    auto object = objectToProcess.first;
-    auto object_children = objectToProcess.second;
-    objectsToProcess.pop();
+  return pending.empty();
+}
 
-    const auto object_id = searcher().getId(object);
-    object_children->mutable_object_id()->set_id(
-      object_id.toString().toStdString());
+bool ObjectGetTreeCall::flatWalk(const Request &request) const {
+  auto flat = m_walk->response.mutable_flat();
+
+  const auto max_depth = treeMaxDepth(request);
+  const auto page_size = treePageSize(request);
+  const auto with_class_names = request.fields().class_name();
+
+  auto &pending = m_walk->pending;
+  auto &class_names = m_walk->class_names;
+  auto slice = TimeSlice(scheduler().getRemainingFrameBudget());
+  while (!pending.empty() && !slice.expired()) {
+    const auto pending_node = pending.back();
+    pending.pop_back();
+
+    const auto index = flat->ids_size();
+    flat->add_ids(pending_node.id);
+    flat->add_parents(pending_node.parent);
+
+    if (with_class_names) {
+      const auto meta_object = pending_node.meta_object;
+      const auto [class_name, inserted] =
+        class_names.try_emplace(meta_object, class_names.size());
+      if (inserted) flat->add_class_name_table(meta_object->className());
+      flat->add_class_names(class_name->second);
+    }
 
-    for (const auto child : object->children()) {
-      objectsToProcess.push(
-        std::make_pair(child, object_children->add_children()));
+    const auto object = pending_node.object.data();
+    const auto children = object ? object->children() : QObjectList{};
+    const auto expanded_children =
+      pending_node.depth < max_depth ? std::min(page_size, children.size())
+                                     : 0;
+    flat->add_child_counts(expanded_children);
+    flat->add_child_totals(children.size());
+
+    for (auto i = expanded_children - 1; i >= 0; --i) {
+      pending.push_back(
+        TreeWalk::flat(children[i], index, pending_node.depth + 1));
     }
   }
 
+  return pending.empty();
+}
 
-  return response;
+void ObjectGetTreeCall::describe(
+  const QObject *object, specter_proto::ObjectNode *node,
+  const specter_proto::ObjectNodeFields &fields) const {
+  if (fields.class_name()) {
+    node->set_class_name(object->metaObject()->className());
+  }
+
+  if (fields.object_name()) {
+    node->set_object_name(object->objectName().toStdString());
+  }
+
+  if (fields.query()) {
+    const auto object_query = searcher().getQuery(object);
+    node->mutable_query()->set_query(object_query.toString().toStdString());
+  }
+
+  if (const auto widget = qobject_cast<const QWidget *>(object); widget) {
+    if (fields.visible()) { node->set_visible(widget->isVisible()); }
+
+    if (fields.geometry()) {
+      const auto position = widget->mapToGlobal(QPoint(0, 0));
+      auto geometry = node->mutable_geometry();
+      geometry->set_x(position.x());
+      geometry->set_y(position.y());
+      geometry->set_width(widget->width());
+      geometry->set_height(widget->height());
+    }
+  }
+
+  const auto &reflection = ReflectionCache::get(object->metaObject());
+  for (const auto &property_name : fields.properties()) {
+    const auto descriptor =
+      reflection.getProperty(QByteArray::fromStdString(property_name));
+    const auto value = descriptor ? descriptor->property.read(object)
+                                  : object->property(property_name.c_str());
+    if (!value.isValid()) continue;
+
+    const auto read_only = descriptor && !descriptor->writable;
+
+    auto property = node->add_properties();
+    property->set_property_name(property_name);
+    *property->mutable_value() = convertIntoValue(value);
+    property->set_read_only(read_only);
+  }
 }
 
 /* ------------------------------ ObjectFindCall -------------------------- */
 
+struct ObjectFindCall::FindWalk {
+  bool started = false;
+  ObjectQuery query = ObjectQuery{};
+  std::deque<QPointer<QObject>> pending;
+  Response response;
+};
+
 ObjectFindCall::ObjectFindCall(
   specter_proto::ObjectService::AsyncService *service,
   grpc::ServerCompletionQueue *queue)
-    : CallData(
+    : SlicedCallData(
         service, queue, CallTag{this},
-        &specter_proto::ObjectService::AsyncService::RequestFind) {}
+        &specter_proto::ObjectService::AsyncService::RequestFind),
+      m_walk(std::make_unique<FindWalk>()) {}
 
 ObjectFindCall::~ObjectFindCall() = default;
 
@@ -176,25 +596,34 @@ std::unique_ptr<ObjectFindCallData> ObjectFindCall::clone() const {
 
 ObjectFindCall::ProcessResult
 ObjectFindCall::process(const Request &request) const {
-  const auto query =
-    ObjectQuery::fromString(QString::fromStdString(request.query()));
+  auto &pending = m_walk->pending;
+  if (!m_walk->started) {
+    m_walk->started = true;
+    m_walk->query =
+      ObjectQuery::fromString(QString::fromStdString(request.query()));
+
+    for (auto top_widget : getTopLevelObjects()) {
+      if (!top_widget->parent()) pending.emplace_back(top_widget);
+    }
+  }
 
-  auto [status, objects] = tryGetObjects(query);
-  if (!status.ok()) return {status, {}};
+  auto slice = TimeSlice(scheduler().getRemainingFrameBudget());
+  while (!pending.empty() && !slice.expired()) {
+    const auto object = pending.front().data();
+    pending.pop_front();
 
-  const auto response = find(objects);
-  return {grpc::Status::OK, response};
-}
+    if (!object) continue;
 
-ObjectFindCall::Response
-ObjectFindCall::find(const QObjectList &objects) const {
-  auto response = ObjectFindCall::Response{};
-  for (const auto object : objects) {
-    const auto id = searcher().getId(object);
-    response.add_ids()->set_id(id.toString().toStdString());
+    if (searcher().matchesQuery(object, m_walk->query)) {
+      const auto id = searcher().getId(object);
+      m_walk->response.add_ids()->set_id(id.toString().toStdString());
+    }
+
+    for (const auto child : object->children()) { pending.emplace_back(child); }
   }
 
-  return response;
+  if (!pending.empty()) return {};
+  return std::make_pair(grpc::Status::OK, std::move(m_walk->response));
 }
 
 /* ------------------------- ObjectGetObjectQueryCallData ------------------- */
@@ -333,156 +762,199 @@ ObjectCallMethodCall::process(const Request &request) const {
   auto [status, object] = tryGetSingleObject(id);
   if (!status.ok()) return {status, {}};
 
-  return invoke(object, request.method_name(), request.arguments());
+  return {
+    invokeMethod(object, request.method_name(), convertArgumentsOf(request)),
+    {}};
 }
 
-ObjectCallMethodCall::ProcessResult ObjectCallMethodCall::invoke(
-  QObject *object, const std::string &method,
-  const google::protobuf::RepeatedPtrField<google::protobuf::Value> &arguments)
-  const {
+/* ------------------------- ObjectUpdatePropertyCall --------------------- */
 
-  auto parameters = QVariantList{};
-  for (const auto &argument : arguments) {
-    parameters.push_back(convertIntoVariant(argument));
-  }
+ObjectUpdatePropertyCall::ObjectUpdatePropertyCall(
+  specter_proto::ObjectService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : CallData(
+        service, queue, CallTag{this},
+        &specter_proto::ObjectService::AsyncService::RequestUpdateProperty) {}
 
-  const auto meta_method = metaMethod(object, method, parameters);
-  if (!meta_method.isValid()) {
-    return {
-      grpc::Status(
-        grpc::StatusCode::INVALID_ARGUMENT,
-        QLatin1String("Method '%1' is unknown.")
-          .arg(method.c_str())
-          .toStdString()),
-      {}};
+ObjectUpdatePropertyCall::~ObjectUpdatePropertyCall() = default;
+
+std::unique_ptr<ObjectUpdatePropertyCallData>
+ObjectUpdatePropertyCall::clone() const {
+  return std::make_unique<ObjectUpdatePropertyCall>(getService(), getQueue());
+}
+
+ObjectUpdatePropertyCall::ProcessResult
+ObjectUpdatePropertyCall::process(const Request &request) const {
+  const auto id =
+    ObjectId::fromString(QString::fromStdString(request.object_id().id()));
+
+  auto [status, object] = tryGetSingleObject(id);
+  if (!status.ok()) return {status, {}};
+
+  auto [write_status, write] = preparePropertyWrite(
+    object, request.property_name(), convertValueOf(request));
+  if (!write_status.ok()) return {write_status, {}};
+
+  return {writeProperty(write, write.value), {}};
+}
+
+/* ------------------------ ObjectUpdatePropertiesCall -------------------- */
+
+ObjectUpdatePropertiesCall::ObjectUpdatePropertiesCall(
+  specter_proto::ObjectService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : CallData(
+        service, queue, CallTag{this},
+        &specter_proto::ObjectService::AsyncService::RequestUpdateProperties) {
+}
+
+ObjectUpdatePropertiesCall::~ObjectUpdatePropertiesCall() = default;
+
+std::unique_ptr<ObjectUpdatePropertiesCallData>
+ObjectUpdatePropertiesCall::clone() const {
+  return std::make_unique<ObjectUpdatePropertiesCall>(getService(), getQueue());
+}
+
+ObjectUpdatePropertiesCall::ProcessResult
+ObjectUpdatePropertiesCall::process(const Request &request) const {
+  const auto aborted = grpc::Status(
+    grpc::StatusCode::ABORTED, "Update was not applied because another "
+                               "update of the batch failed");
+
+  auto response = Response{};
+  auto writes = std::vector<std::optional<PropertyWrite>>{};
+  writes.reserve(request.updates_size());
+
+  auto prepared = true;
+  for (const auto &update : request.updates()) {
+    auto object_status = response.add_statuses();
+    *object_status->mutable_object_id() = update.object_id();
+
+    const auto id =
+      ObjectId::fromString(QString::fromStdString(update.object_id().id()));
+
+    auto [status, object] = tryGetSingleObject(id);
+    if (status.ok()) {
+      auto [write_status, write] = preparePropertyWrite(
+        object, update.property_name(), convertValueOf(update));
+      if (write_status.ok()) writes.emplace_back(std::move(write));
+      status = write_status;
+    }
+
+    if (!status.ok()) writes.emplace_back(std::nullopt);
+
+    prepared = prepared && status.ok();
+    object_status->set_code(status.error_code());
+    object_status->set_message(status.error_message());
   }
 
-  for (auto i = 0; i < meta_method.parameterCount(); ++i) {
-    const auto parameter_meta_type = meta_method.parameterMetaType(i);
-    auto &parameter = parameters[i];
+  if (request.atomic() && !prepared) {
+    for (auto i = 0; i < response.statuses_size(); ++i) {
+      if (!writes[i]) continue;
+      response.mutable_statuses(i)->set_code(aborted.error_code());
+      response.mutable_statuses(i)->set_message(aborted.error_message());
+    }
 
-    parameter.convert(parameter_meta_type);
+    return {grpc::Status::OK, response};
   }
 
-  const auto _generic_arg = [&parameters](auto index) {
-    return parameters.size() > index
-             ? QGenericArgument(
-                 parameters[index].typeName(), parameters[index].data())
-             : QGenericArgument{};
-  };
+  auto old_values = QVariantList{};
+  old_values.reserve(writes.size());
 
-  meta_method.invoke(
-    object, Qt::QueuedConnection, _generic_arg(0), _generic_arg(1),
-    _generic_arg(2), _generic_arg(3), _generic_arg(4), _generic_arg(5),
-    _generic_arg(6), _generic_arg(7), _generic_arg(8), _generic_arg(9));
+  for (auto i = std::size_t{0}; i < writes.size(); ++i) {
+    const auto &write = writes[i];
+    old_values.append(write && request.atomic() ? readProperty(*write)
+                                                : QVariant{});
+    if (!write) continue;
 
-  return {grpc::Status::OK, {}};
-}
+    const auto status = writeProperty(*write, write->value);
+    if (status.ok()) continue;
 
-QMetaMethod ObjectCallMethodCall::metaMethod(
-  const QObject *object, const std::string &name,
-  const QVariantList &parameters) const {
-  const auto meta_object = object->metaObject();
+    auto object_status = response.mutable_statuses(int(i));
+    object_status->set_code(status.error_code());
+    object_status->set_message(status.error_message());
+
+    if (!request.atomic()) continue;
 
-  for (auto i = 0; i < meta_object->methodCount(); ++i) {
-    const auto method = meta_object->method(i);
-    if (method.name() != QByteArray::fromStdString(name)) continue;
-    if (method.parameterCount() != parameters.size()) continue;
+    for (auto j = i; j-- > 0;) {
+      if (!writes[j]) continue;
+      writeProperty(*writes[j], old_values[qsizetype(j)]);
+    }
 
-    for (auto i = 0; i < method.parameterCount(); ++i) {
-      const auto parameter_meta_type = method.parameterMetaType(i);
-      if (!parameters[i].canConvert(parameter_meta_type)) continue;
+    for (auto j = std::size_t{0}; j < writes.size(); ++j) {
+      if (j == i || !writes[j]) continue;
+      response.mutable_statuses(int(j))->set_code(aborted.error_code());
+      response.mutable_statuses(int(j))->set_message(aborted.error_message());
     }
 
-    return method;
+    break;
   }
 
-  return QMetaMethod{};
+  return {grpc::Status::OK, response};
 }
 
-/* ------------------------- ObjectUpdatePropertyCall --------------------- */
+/* -------------------------- ObjectApplyToQueryCall ---------------------- */
 
-ObjectUpdatePropertyCall::ObjectUpdatePropertyCall(
+ObjectApplyToQueryCall::ObjectApplyToQueryCall(
   specter_proto::ObjectService::AsyncService *service,
   grpc::ServerCompletionQueue *queue)
     : CallData(
         service, queue, CallTag{this},
-        &specter_proto::ObjectService::AsyncService::RequestUpdateProperty) {}
+        &specter_proto::ObjectService::AsyncService::RequestApplyToQuery) {}
 
-ObjectUpdatePropertyCall::~ObjectUpdatePropertyCall() = default;
+ObjectApplyToQueryCall::~ObjectApplyToQueryCall() = default;
 
-std::unique_ptr<ObjectUpdatePropertyCallData>
-ObjectUpdatePropertyCall::clone() const {
-  return std::make_unique<ObjectUpdatePropertyCall>(getService(), getQueue());
+std::unique_ptr<ObjectApplyToQueryCallData>
+ObjectApplyToQueryCall::clone() const {
+  return std::make_unique<ObjectApplyToQueryCall>(getService(), getQueue());
 }
 
-ObjectUpdatePropertyCall::ProcessResult
-ObjectUpdatePropertyCall::process(const Request &request) const {
-  const auto id =
-    ObjectId::fromString(QString::fromStdString(request.object_id().id()));
+ObjectApplyToQueryCall::ProcessResult
+ObjectApplyToQueryCall::process(const Request &request) const {
+  const auto query =
+    ObjectQuery::fromString(QString::fromStdString(request.query().query()));
 
-  auto [status, object] = tryGetSingleObject(id);
+  auto [status, objects] = tryGetObjects(query);
   if (!status.ok()) return {status, {}};
 
-  return setProperty(object, request.property_name(), request.value());
-}
+  auto response = Response{};
+  switch (request.action_case()) {
+    case Request::kAssignment: {
+      const auto &assignment = request.assignment();
+      const auto value = convertValueOf(assignment);
 
-ObjectUpdatePropertyCall::ProcessResult ObjectUpdatePropertyCall::setProperty(
-  QObject *object, const std::string &property,
-  const google::protobuf::Value &value) const {
+      for (const auto object : objects) {
+        auto [write_status, write] =
+          preparePropertyWrite(object, assignment.property_name(), value);
+        if (write_status.ok()) {
+          write_status = writeProperty(write, write.value);
+        }
 
-  const auto property_name = QByteArray::fromStdString(property);
-  auto property_meta_type = object->property(property_name).metaType();
+        setObjectStatus(response.add_statuses(), object, write_status);
+      }
+      break;
+    }
 
-  if (property_meta_type.id() == QMetaType::UnknownType) {
-    return {
-      grpc::Status(
-        grpc::StatusCode::INVALID_ARGUMENT,
-        QLatin1String("Property '%1' type is unknown.")
-          .arg(property_name)
-          .toStdString()),
-      {}};
-  }
+    case Request::kInvocation: {
+      const auto &invocation = request.invocation();
+      const auto parameters = convertArgumentsOf(invocation);
 
-  auto new_value = convertIntoVariant(value);
-  if (!new_value.convert(property_meta_type)) {
-    return {
-      grpc::Status(
-        grpc::StatusCode::INVALID_ARGUMENT,
-        QLatin1String("Property '%1' value '%2' is incorrect.")
-          .arg(property_name)
-          .arg(new_value.toString())
-          .toStdString()),
-      {}};
-  }
+      for (const auto object : objects) {
+        setObjectStatus(
+          response.add_statuses(), object,
+          invokeMethod(object, invocation.method_name(), parameters));
+      }
+      break;
+    }
 
-  auto index = object->metaObject()->indexOfProperty(property_name);
-  if (index >= 0) {
-    QMetaProperty property = object->metaObject()->property(index);
-    if (!property.isWritable()) {
-      QString error_msg =
-        QLatin1String("Property '%1' could not be set to '%2'. "
-                      "The property may not exist or is not writable.")
-          .arg(property_name, new_value.toString());
+    case Request::ACTION_NOT_SET:
       return {
         grpc::Status(
-          grpc::StatusCode::INVALID_ARGUMENT, error_msg.toStdString()),
+          grpc::StatusCode::INVALID_ARGUMENT, "There is no action to apply"),
         {}};
-    }
-  }
-
-  auto ret = object->setProperty(property_name, new_value);
-  if (!ret) {
-    return {
-      grpc::Status(
-        grpc::StatusCode::INVALID_ARGUMENT,
-        QLatin1String("Property '%1' set failed.")
-          .arg(property_name)
-          .toStdString()),
-      {}};
   }
 
-  return {grpc::Status::OK, {}};
+  return {grpc::Status::OK, response};
 }
 
 /* --------------------------- ObjectGetMethodsCall ---------------------- */
@@ -514,46 +986,19 @@ ObjectGetMethodsCall::Response
 ObjectGetMethodsCall::methods(const QObject *object) const {
   auto response = ObjectGetMethodsCall::Response{};
 
-  auto meta_object = object->metaObject();
-  for (auto i = 0; i < meta_object->methodCount(); ++i) {
-    const auto meta_method = meta_object->method(i);
-
-    if (meta_method.access() != QMetaMethod::Access::Public) { continue; }
-    if (
-      meta_method.methodType() != QMetaMethod::Slot &&
-      meta_method.methodType() != QMetaMethod::Method) {
-      continue;
-    }
-
-    bool skip_current_method = false;
-    std::vector<std::pair<std::string, QVariant>> collected_parameters_data;
-
-    for (int j = 0; j < meta_method.parameterCount(); ++j) {
-      auto parameter_name = meta_method.parameterNames().at(j).toStdString();
-      if (parameter_name.empty()) {
-        parameter_name = QString("arg%1").arg(QString::number(j)).toStdString();
-      }
-
-      auto parameter_default_value_qvariant =
-        QVariant(QMetaType(meta_method.parameterType(j)));
-      if (!parameter_default_value_qvariant.isValid()) {
-        skip_current_method = true;
-        break;
-      }
-
-      collected_parameters_data.emplace_back(
-        parameter_name, parameter_default_value_qvariant);
-    }
+  const auto &reflection = ReflectionCache::get(object->metaObject());
+  for (const auto &method : reflection.getMethods()) {
+    if (!method.listed) continue;
 
-    if (skip_current_method) { continue; }
     auto proto_method = response.add_methods();
-    proto_method->set_method_name(QString(meta_method.name()).toStdString());
+    proto_method->set_method_name(method.name.toStdString());
 
-    for (const auto &param_data : collected_parameters_data) {
+    for (auto i = 0; i < method.parameter_names.size(); ++i) {
       auto proto_parameter = proto_method->add_parameters();
-      proto_parameter->set_parameter_name(param_data.first);
+      proto_parameter->set_parameter_name(
+        method.parameter_names[i].toStdString());
       *proto_parameter->mutable_default_value() =
-        convertIntoValue(param_data.second);
+        convertIntoValue(method.default_values[i]);
     }
   }
 
@@ -583,38 +1028,115 @@ ObjectGetPropertiesCall::process(const Request &request) const {
   auto [status, object] = tryGetSingleObject(id);
   if (!status.ok()) return {status, {}};
 
-  return {grpc::Status::OK, properties(object)};
+  const auto filter =
+    PropertyFilter(convertIntoStringList(request.properties()));
+  return {
+    grpc::Status::OK, properties(object, filter, request.encoding())};
 }
 
-ObjectGetPropertiesCall::Response
-ObjectGetPropertiesCall::properties(const QObject *object) const {
+ObjectGetPropertiesCall::Response ObjectGetPropertiesCall::properties(
+  const QObject *object, const PropertyFilter &filter,
+  specter_proto::ValueEncoding encoding) const {
   auto response = ObjectGetPropertiesCall::Response{};
+  readProperties(object, filter, encoding, response.mutable_properties());
+
+  return response;
+}
+
+/* ------------------------ ObjectGetPropertiesBulkCall ----------------- */
+
+struct ObjectGetPropertiesBulkCall::BulkRead {
+  QList<ObjectId> ids;
+  QList<QPointer<QObject>> objects;
+  PropertyFilter filter;
+  specter_proto::ValueEncoding encoding = specter_proto::STRUCT;
+  qsizetype next = 0;
+  qsizetype chunk_size = 0;
+};
+
+ObjectGetPropertiesBulkCall::ObjectGetPropertiesBulkCall(
+  specter_proto::ObjectService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : StreamCallData(
+        service, queue, CallTag{this},
+        &specter_proto::ObjectService::AsyncService::RequestGetPropertiesBulk,
+        TaskPriority::Unary),
+      m_read(std::make_unique<BulkRead>()) {}
 
-  auto unique_properties = std::set<std::string>{};
-  auto meta_object = object->metaObject();
-  for (auto i = 0; i < meta_object->propertyCount(); ++i) {
-    const auto name = meta_object->property(i).name();
-    const auto read_only = !meta_object->property(i).isWritable();
-    unique_properties.insert(name);
+ObjectGetPropertiesBulkCall::~ObjectGetPropertiesBulkCall() = default;
+
+ObjectGetPropertiesBulkCall::StartResult
+ObjectGetPropertiesBulkCall::start(const Request &request) const {
+  m_read->filter = PropertyFilter(convertIntoStringList(request.properties()));
+  m_read->encoding = request.encoding();
+  m_read->chunk_size = request.has_chunk_size() && request.chunk_size() > 0
+                         ? qsizetype(request.chunk_size())
+                         : 64;
+
+  auto objects = QObjectList{};
+  if (request.has_query()) {
+    const auto query =
+      ObjectQuery::fromString(QString::fromStdString(request.query().query()));
+
+    auto [status, found_objects] = tryGetObjects(query);
+    if (!status.ok()) return status;
+
+    objects = found_objects;
+    for (const auto object : objects) {
+      m_read->ids.append(searcher().getId(object));
+    }
   }
 
-  for (auto unique_property : unique_properties) {
-    const auto value = object->property(unique_property.c_str());
+  auto requested_ids = QList<ObjectId>{};
+  for (const auto &object_id : request.ids()) {
+    requested_ids.append(
+      ObjectId::fromString(QString::fromStdString(object_id.id())));
+  }
+
+  m_read->ids.append(requested_ids);
+  objects.append(searcher().getObjects(requested_ids));
+
+  m_read->objects.reserve(objects.size());
+  for (const auto object : objects) { m_read->objects.append(object); }
+
+  return {};
+}
+
+ObjectGetPropertiesBulkCall::ProcessResult
+ObjectGetPropertiesBulkCall::process() const {
+  if (m_read->next >= m_read->objects.size()) return grpc::Status::OK;
 
-    auto property_index =
-      object->metaObject()->indexOfProperty(unique_property.c_str());
-    auto read_only =
-      !object->metaObject()->property(property_index).isWritable();
+  const auto end =
+    std::min(m_read->next + m_read->chunk_size, m_read->objects.size());
 
-    auto new_properties = response.add_properties();
-    new_properties->set_property_name(unique_property);
-    *new_properties->mutable_value() = convertIntoValue(value);
-    new_properties->set_read_only(read_only);
+  auto response = Response{};
+  for (; m_read->next < end; ++m_read->next) {
+    const auto &object = m_read->objects[m_read->next];
+    const auto &object_id = m_read->ids[m_read->next];
+
+    auto object_properties = response.add_objects();
+    object_properties->mutable_object_id()->set_id(
+      object_id.toString().toStdString());
+
+    if (!object) {
+      object_properties->set_error("There is not object for passed id");
+      continue;
+    }
+
+    readProperties(
+      object, m_read->filter, m_read->encoding,
+      object_properties->mutable_properties());
   }
 
   return response;
 }
 
+std::unique_ptr<ObjectGetPropertiesBulkCallData>
+ObjectGetPropertiesBulkCall::clone() const {
+  return std::make_unique<ObjectGetPropertiesBulkCall>(
+    getService(), getQueue());
+}
+
 /* ------------------------ ObjectListenTreeChangesCall ----------------- */
 
 ObjectListenTreeChangesCall::ObjectListenTreeChangesCall(
@@ -668,6 +1190,7 @@ ObjectListenPropertyChangesCall::ObjectListenPropertyChangesCall(
       m_mapper(std::make_unique<PropertyObservedActionsMapper>()) {
 
   m_observer_queue->setObserver(m_observer.get());
+  m_observer_queue->setNotifier([this]() { wake(); });
 }
 
 ObjectListenPropertyChangesCall::~ObjectListenPropertyChangesCall() = default;
@@ -680,6 +1203,14 @@ ObjectListenPropertyChangesCall::start(const Request &request) const {
   if (!status.ok()) return status;
 
   m_observer->setObject(object);
+  m_observer->setFilter(
+    PropertyFilter(convertIntoStringList(request.properties())));
+  if (request.has_polling_interval_ms()) {
+    m_observer->setPollingInterval(
+      std::chrono::milliseconds(qMax(request.polling_interval_ms(), 1u)));
+  }
+  m_observer_queue->setMaxRate(request.max_rate());
+  m_mapper->setEncoding(request.encoding());
   m_observer->start();
   return {};
 }
@@ -687,7 +1218,7 @@ ObjectListenPropertyChangesCall::start(const Request &request) const {
 
 ObjectListenPropertyChangesCall::ProcessResult
 ObjectListenPropertyChangesCall::process() const {
-  if (m_observer_queue->isEmpty()) return {};
+  if (!m_observer_queue->isReady()) return {};
 
   const auto observer_action = m_observer_queue->popAction();
   const auto response = observer_action.visit(*m_mapper);
@@ -695,12 +1226,156 @@ ObjectListenPropertyChangesCall::process() const {
   return response;
 }
 
+std::chrono::milliseconds
+ObjectListenPropertyChangesCall::getCheckDelay() const {
+  return std::clamp(
+    m_observer_queue->getDelay(), std::chrono::milliseconds(1),
+    ObjectListenPropertyChangesCallData::getCheckDelay());
+}
+
 std::unique_ptr<ObjectListenPropertyChangesCallData>
 ObjectListenPropertyChangesCall::clone() const {
   return std::make_unique<ObjectListenPropertyChangesCall>(
     getService(), getQueue());
 }
 
+/* ------------------------ ObjectSubscribePropertiesCall ----------------- */
+
+ObjectSubscribePropertiesCall::ObjectSubscribePropertiesCall(
+  specter_proto::ObjectService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : StreamCallData(
+        service, queue, CallTag{this},
+        &specter_proto::ObjectService::AsyncService::
+          RequestSubscribeProperties),
+      m_subscription(std::make_unique<PropertySubscription>()),
+      m_mapper(std::make_unique<PropertyObservedActionsMapper>()),
+      m_announced(false) {
+
+  QObject::connect(
+    m_subscription.get(), &PropertySubscription::changesReported,
+    [this]() { wake(); });
+}
+
+ObjectSubscribePropertiesCall::~ObjectSubscribePropertiesCall() = default;
+
+ObjectSubscribePropertiesCall::StartResult
+ObjectSubscribePropertiesCall::start(const Request &request) const {
+  auto objects = QObjectList{};
+  for (const auto &object_id : request.ids()) {
+    const auto id =
+      ObjectId::fromString(QString::fromStdString(object_id.id()));
+
+    auto [status, object] = tryGetSingleObject(id);
+    if (!status.ok()) return status;
+    objects.push_back(object);
+  }
+
+  m_subscription->setMaxRate(request.max_rate());
+  m_mapper->setEncoding(request.encoding());
+
+  for (const auto object : objects) { m_subscription->addObject(object); }
+  for (const auto &query : request.queries()) {
+    m_subscription->addQuery(
+      ObjectQuery::fromString(QString::fromStdString(query.query())));
+  }
+
+  return {};
+}
+
+ObjectSubscribePropertiesCall::ProcessResult
+ObjectSubscribePropertiesCall::process() const {
+  if (m_announced && !m_subscription->isReady()) return {};
+
+  auto response = Response{};
+  if (!std::exchange(m_announced, true)) {
+    response.set_subscription_id(m_subscription->getId().toStdString());
+  }
+
+  for (const auto &change : m_subscription->takeChanges()) {
+    auto object_change = response.add_changes();
+    object_change->mutable_object_id()->set_id(
+      change.object_id.toString().toStdString());
+    *object_change->mutable_change() = change.action.visit(*m_mapper);
+  }
+
+  return response;
+}
+
+std::chrono::milliseconds
+ObjectSubscribePropertiesCall::getCheckDelay() const {
+  return std::clamp(
+    m_subscription->getDelay(), std::chrono::milliseconds(1),
+    ObjectSubscribePropertiesCallData::getCheckDelay());
+}
+
+std::unique_ptr<ObjectSubscribePropertiesCallData>
+ObjectSubscribePropertiesCall::clone() const {
+  return std::make_unique<ObjectSubscribePropertiesCall>(
+    getService(), getQueue());
+}
+
+/* --------------------- ObjectUpdatePropertySubscriptionCall ------------- */
+
+ObjectUpdatePropertySubscriptionCall::ObjectUpdatePropertySubscriptionCall(
+  specter_proto::ObjectService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : CallData(
+        service, queue, CallTag{this},
+        &specter_proto::ObjectService::AsyncService::
+          RequestUpdatePropertySubscription) {}
+
+ObjectUpdatePropertySubscriptionCall::~ObjectUpdatePropertySubscriptionCall() =
+  default;
+
+std::unique_ptr<ObjectUpdatePropertySubscriptionCallData>
+ObjectUpdatePropertySubscriptionCall::clone() const {
+  return std::make_unique<ObjectUpdatePropertySubscriptionCall>(
+    getService(), getQueue());
+}
+
+ObjectUpdatePropertySubscriptionCall::ProcessResult
+ObjectUpdatePropertySubscriptionCall::process(const Request &request) const {
+  auto subscription = PropertySubscription::find(
+    QString::fromStdString(request.subscription_id()));
+  if (!subscription) {
+    return {
+      grpc::Status(
+        grpc::StatusCode::INVALID_ARGUMENT,
+        "There is no subscription for passed id"),
+      {}};
+  }
+
+  auto added_objects = QObjectList{};
+  for (const auto &object_id : request.add_ids()) {
+    const auto id =
+      ObjectId::fromString(QString::fromStdString(object_id.id()));
+
+    auto [status, object] = tryGetSingleObject(id);
+    if (!status.ok()) return {status, {}};
+    added_objects.push_back(object);
+  }
+
+  for (const auto &object_id : request.remove_ids()) {
+    subscription->removeObject(
+      ObjectId::fromString(QString::fromStdString(object_id.id())));
+  }
+
+  for (const auto object : added_objects) { subscription->addObject(object); }
+
+  for (const auto &query : request.remove_queries()) {
+    subscription->removeQuery(
+      ObjectQuery::fromString(QString::fromStdString(query.query())));
+  }
+
+  for (const auto &query : request.add_queries()) {
+    subscription->addQuery(
+      ObjectQuery::fromString(QString::fromStdString(query.query())));
+  }
+
+  return {grpc::Status::OK, {}};
+}
+
 /* ------------------------------ ObjectService --------------------------- */
 
 ObjectService::ObjectService() = default;
@@ -715,11 +1390,17 @@ void ObjectService::start(grpc::ServerCompletionQueue *queue) {
   auto children_call = new ObjectChildrenCall(this, queue);
   auto call_method_call = new ObjectCallMethodCall(this, queue);
   auto update_property_call = new ObjectUpdatePropertyCall(this, queue);
+  auto update_properties_call = new ObjectUpdatePropertiesCall(this, queue);
+  auto apply_to_query_call = new ObjectApplyToQueryCall(this, queue);
   auto get_methods_call = new ObjectGetMethodsCall(this, queue);
   auto get_properties_call = new ObjectGetPropertiesCall(this, queue);
+  auto get_properties_bulk_call = new ObjectGetPropertiesBulkCall(this, queue);
   auto listen_tree_changes = new ObjectListenTreeChangesCall(this, queue);
   auto listen_property_changes =
     new ObjectListenPropertyChangesCall(this, queue);
+  auto subscribe_properties = new ObjectSubscribePropertiesCall(this, queue);
+  auto update_property_subscription =
+    new ObjectUpdatePropertySubscriptionCall(this, queue);
 
   get_tree_call->proceed();
   find_call->proceed();
@@ -728,10 +1409,15 @@ void ObjectService::start(grpc::ServerCompletionQueue *queue) {
   children_call->proceed();
   call_method_call->proceed();
   update_property_call->proceed();
+  update_properties_call->proceed();
+  apply_to_query_call->proceed();
   get_methods_call->proceed();
   get_properties_call->proceed();
+  get_properties_bulk_call->proceed();
   listen_tree_changes->proceed();
   listen_property_changes->proceed();
+  subscribe_properties->proceed();
+  update_property_subscription->proceed();
 }
 
 }// namespace specter
@@ -2,13 +2,160 @@
 #include "specter/service/previewer.h"
 
 #include "specter/module.h"
+#include "specter/observe/preview/comparator.h"
 #include "specter/observe/preview/observer.h"
+#include "specter/observe/preview/recording.h"
+#include "specter/observe/preview/ring.h"
 #include "specter/search/utils.h"
 #include "specter/service/utils.h"
 /* ------------------------------------ Qt ---------------------------------- */
 #include <QApplication>
+#include <QDir>
+#include <QScreen>
+#include <QThreadPool>
+#include <QUuid>
+#include <QWidget>
+/* --------------------------------- Standard ------------------------------- */
+#include <algorithm>
+#include <map>
+#include <utility>
 /* -------------------------------------------------------------------------- */
 
+namespace {
+
+std::map<QString, std::unique_ptr<specter::PreviewRecording>> &
+getRecordings() {
+  static auto recordings =
+    std::map<QString, std::unique_ptr<specter::PreviewRecording>>{};
+  return recordings;
+}
+
+QRect toRect(const specter_proto::Rect &rect) {
+  return QRect(rect.x(), rect.y(), rect.width(), rect.height());
+}
+
+void setRect(specter_proto::Rect *proto_rect, const QRect &rect) {
+  proto_rect->set_x(rect.x());
+  proto_rect->set_y(rect.y());
+  proto_rect->set_width(rect.width());
+  proto_rect->set_height(rect.height());
+}
+
+template<typename REQUEST>
+specter::PreviewFormat encodingFormat(const REQUEST &request) {
+  auto format = specter::PreviewFormat{};
+  format.codec = static_cast<specter::PreviewCodec>(request.codec());
+  format.quality = request.has_quality() ? int(request.quality()) : -1;
+  if (request.has_max_size()) {
+    format.max_size =
+      QSize(int(request.max_size().width()), int(request.max_size().height()));
+  }
+
+  return format;
+}
+
+specter::PreviewFormat
+previewFormat(const specter_proto::PreviewRequest &request) {
+  auto format = encodingFormat(request);
+  format.delta = request.delta();
+  if (request.has_tile_size()) format.tile_size = int(request.tile_size());
+  if (request.has_keyframe_interval()) {
+    format.keyframe_interval = int(request.keyframe_interval());
+  }
+
+  return format;
+}
+
+QRect previewRegion(const specter_proto::PreviewRequest &request) {
+  return request.has_region() ? toRect(request.region()) : QRect{};
+}
+
+QImage grabScreen(const specter_proto::Rect &screen_region) {
+  const auto region = toRect(screen_region);
+
+  auto screen = QGuiApplication::screenAt(region.center());
+  if (!screen) screen = QGuiApplication::primaryScreen();
+  if (!screen) return {};
+
+  const auto origin = screen->geometry().topLeft();
+  return screen
+    ->grabWindow(
+      0, region.x() - origin.x(), region.y() - origin.y(), region.width(),
+      region.height())
+    .toImage();
+}
+
+specter_proto::PreviewCodec previewCodec(specter::PreviewCodec codec) {
+  return static_cast<specter_proto::PreviewCodec>(codec);
+}
+
+std::pair<grpc::Status, QString> addReference(const std::string &image) {
+  const auto [reference_status, hash] =
+    specter::ImageComparator::addReference(QByteArray::fromStdString(image));
+
+  switch (reference_status) {
+    case specter::ReferenceStatus::Added:
+      return {grpc::Status::OK, hash};
+
+    case specter::ReferenceStatus::Invalid:
+      return {
+        grpc::Status(
+          grpc::StatusCode::INVALID_ARGUMENT,
+          "The reference image cannot be decoded"),
+        {}};
+
+    case specter::ReferenceStatus::TooLarge:
+      return {
+        grpc::Status(
+          grpc::StatusCode::RESOURCE_EXHAUSTED,
+          "The reference image exceeds the allowed size"),
+        {}};
+  }
+
+  return {grpc::Status(grpc::StatusCode::INTERNAL, ""), {}};
+}
+
+std::pair<grpc::Status, specter_proto::RecordedFrame> readRecordedFrame(
+  const QString &path, qint64 timestamp,
+  const specter::PreviewFormat &format) {
+  if (!QFile::exists(path)) {
+    return {
+      grpc::Status(
+        grpc::StatusCode::NOT_FOUND, "There is no recording for passed id"),
+      {}};
+  }
+
+  auto reader = specter::PreviewRecordingReader(path);
+  const auto recorded =
+    reader.open() ? reader.readFrame(timestamp) : std::nullopt;
+  if (!recorded) {
+    if (!reader.getErrorString().isEmpty()) {
+      return {
+        grpc::Status(
+          grpc::StatusCode::DATA_LOSS, reader.getErrorString().toStdString()),
+        {}};
+    }
+
+    return {
+      grpc::Status(
+        grpc::StatusCode::OUT_OF_RANGE,
+        "There is no recorded frame for passed timestamp"),
+      {}};
+  }
+
+  const auto frame = specter::PreviewEncoder::encode(recorded->image, format);
+
+  specter_proto::RecordedFrame response;
+  response.set_image(frame.data.constData(), frame.data.size());
+  response.set_width(frame.size.width());
+  response.set_height(frame.size.height());
+  response.set_codec(previewCodec(frame.codec));
+  response.set_timestamp_msecs(recorded->timestamp);
+  return {grpc::Status::OK, response};
+}
+
+}// namespace
+
 namespace specter {
 
 /* ------------------------- PreviewerListenCommandsCall -------------------- */
@@ -18,11 +165,12 @@ PreviewerListenCommandsCall::PreviewerListenCommandsCall(
   grpc::ServerCompletionQueue *queue)
     : StreamCallData(
         service, queue, CallTag{this},
-        &specter_proto::PreviewerService::AsyncService::RequestListenPreview),
-      m_observer(std::make_unique<PreviewObserver>()),
-      m_observer_queue(std::make_unique<PreviewObserverQueue>()) {
+        &specter_proto::PreviewerService::AsyncService::RequestListenPreview,
+        TaskPriority::Preview),
+      m_observer_queue(std::make_unique<PreviewObserverQueue>()),
+      m_announced(false) {
 
-  m_observer_queue->setObserver(m_observer.get());
+  m_observer_queue->setNotifier([this]() { wake(); });
 }
 
 PreviewerListenCommandsCall::~PreviewerListenCommandsCall() = default;
@@ -40,23 +188,418 @@ PreviewerListenCommandsCall::start(const Request &request) const {
   auto [status, object] = tryGetSingleObject(id);
   if (!status.ok()) return status;
 
-  m_observer->setObject(object);
-  m_observer->start();
+  auto format = previewFormat(request);
+  if (request.has_shared_memory()) {
+    const auto &shared_memory = request.shared_memory();
+    if (
+      shared_memory.slot_count() > PreviewRing::max_slot_count ||
+      shared_memory.slot_size() > PreviewRing::max_slot_size) {
+      return grpc::Status(
+        grpc::StatusCode::INVALID_ARGUMENT,
+        "The shared memory ring exceeds the allowed slot count or size");
+    }
+
+    m_ring = std::make_unique<PreviewRing>(
+      shared_memory.slot_count(), shared_memory.slot_size());
+
+    if (!m_ring->create()) {
+      return grpc::Status(
+        grpc::StatusCode::RESOURCE_EXHAUSTED,
+        m_ring->getErrorString().toStdString());
+    }
+
+    format.delta = false;
+  }
+
+  m_observer =
+    PreviewObserver::acquire(object, format, previewRegion(request));
+  m_observer_queue->setMaxRate(request.max_fps());
+  m_observer_queue->setObserver(m_observer.get());
   return {};
 }
 
 PreviewerListenCommandsCall::ProcessResult
 PreviewerListenCommandsCall::process() const {
-  if (m_observer_queue->isEmpty()) return {};
+  m_observer_queue->setPaused(false);
+  if (!m_observer_queue->isReady()) return {};
 
   const auto observer_preview = m_observer_queue->popPreview();
+  m_observer_queue->setPaused(true);
 
   specter_proto::PreviewImage response;
-  response.set_image(observer_preview.constData(), observer_preview.size());
+  const auto slot =
+    m_ring ? m_ring->write(observer_preview) : std::optional<PreviewRingSlot>{};
+  if (slot) {
+    auto shared_slot = response.mutable_shared_slot();
+    shared_slot->set_key(m_ring->getKey().toStdString());
+    shared_slot->set_slot(slot->index);
+    shared_slot->set_sequence(slot->sequence);
+    shared_slot->set_size(slot->size);
+  } else {
+    response.set_image(
+      observer_preview.data.constData(), observer_preview.data.size());
+  }
+  response.set_width(observer_preview.size.width());
+  response.set_height(observer_preview.size.height());
+  response.set_codec(previewCodec(observer_preview.codec));
+  response.set_keyframe(observer_preview.keyframe);
+  response.set_dropped_frames(
+    m_observer_queue->getDroppedFrames() + m_observer->getDroppedFrames());
+
+  for (const auto &observer_tile : observer_preview.tiles) {
+    auto tile = response.add_tiles();
+    setRect(tile->mutable_rect(), observer_tile.rect);
+    tile->set_image(observer_tile.data.constData(), observer_tile.data.size());
+  }
+
+  if (!std::exchange(m_announced, true)) {
+    response.set_stream_id(m_observer->getId().toStdString());
+  }
 
   return response;
 }
 
+std::chrono::milliseconds PreviewerListenCommandsCall::getCheckDelay() const {
+  return std::clamp(
+    m_observer_queue->getDelay(), std::chrono::milliseconds(1),
+    PreviewerListenCommandsCallData::getCheckDelay());
+}
+
+/* ------------------------- PreviewerForceKeyframeCall --------------------- */
+
+PreviewerForceKeyframeCall::PreviewerForceKeyframeCall(
+  specter_proto::PreviewerService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : CallData(
+        service, queue, CallTag{this},
+        &specter_proto::PreviewerService::AsyncService::RequestForceKeyframe) {
+}
+
+PreviewerForceKeyframeCall::~PreviewerForceKeyframeCall() = default;
+
+std::unique_ptr<PreviewerForceKeyframeCallData>
+PreviewerForceKeyframeCall::clone() const {
+  return std::make_unique<PreviewerForceKeyframeCall>(
+    getService(), getQueue());
+}
+
+PreviewerForceKeyframeCall::ProcessResult
+PreviewerForceKeyframeCall::process(const Request &request) const {
+  auto observer =
+    PreviewObserver::find(QString::fromStdString(request.stream_id()));
+  if (!observer) {
+    return {
+      grpc::Status(
+        grpc::StatusCode::INVALID_ARGUMENT,
+        "There is not preview stream for passed id"),
+      {}};
+  }
+
+  observer->requestKeyframe();
+  return {grpc::Status::OK, {}};
+}
+
+/* --------------------------- PreviewerScreenshotCall ---------------------- */
+
+PreviewerScreenshotCall::PreviewerScreenshotCall(
+  specter_proto::PreviewerService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : AsyncCallData(
+        service, queue, CallTag{this},
+        &specter_proto::PreviewerService::AsyncService::RequestScreenshot) {}
+
+PreviewerScreenshotCall::~PreviewerScreenshotCall() = default;
+
+std::unique_ptr<PreviewerScreenshotCallData>
+PreviewerScreenshotCall::clone() const {
+  return std::make_unique<PreviewerScreenshotCall>(getService(), getQueue());
+}
+
+void PreviewerScreenshotCall::process(
+  const Request &request, Finisher finish) const {
+  auto statuses = QList<grpc::Status>{};
+  auto images = QList<QImage>{};
+
+  for (const auto &object_id : request.object_ids()) {
+    const auto id =
+      ObjectId::fromString(QString::fromStdString(object_id.id()));
+
+    auto [status, widget] = tryGetSingleWidget(id);
+    statuses.append(status);
+    images.append(status.ok() ? widget->grab().toImage() : QImage{});
+  }
+
+  if (request.has_screen_region()) {
+    statuses.append(grpc::Status::OK);
+    images.append(grabScreen(request.screen_region()));
+  }
+
+  PreviewEncoder::encode(
+    std::move(images), encodingFormat(request),
+    [object_ids = request.object_ids(), statuses = std::move(statuses),
+     finish = std::move(finish)](const QList<PreviewFrame> &frames) {
+      specter_proto::Screenshots response;
+      for (auto i = 0; i < frames.size(); ++i) {
+        auto status = statuses[i];
+        if (status.ok() && frames[i].data.isEmpty()) {
+          status = grpc::Status(
+            grpc::StatusCode::INTERNAL, "Failed to capture the screenshot");
+        }
+
+        auto screenshot = response.add_screenshots();
+        if (i < object_ids.size()) {
+          *screenshot->mutable_status()->mutable_object_id() = object_ids[i];
+        }
+        screenshot->mutable_status()->set_code(status.error_code());
+        screenshot->mutable_status()->set_message(status.error_message());
+
+        if (!status.ok()) continue;
+
+        const auto &frame = frames[i];
+        screenshot->set_image(frame.data.constData(), frame.data.size());
+        screenshot->set_width(frame.size.width());
+        screenshot->set_height(frame.size.height());
+        screenshot->set_codec(previewCodec(frame.codec));
+      }
+
+      finish({grpc::Status::OK, response});
+    });
+}
+
+/* ------------------------ PreviewerUploadReferenceCall -------------------- */
+
+PreviewerUploadReferenceCall::PreviewerUploadReferenceCall(
+  specter_proto::PreviewerService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : CallData(
+        service, queue, CallTag{this},
+        &specter_proto::PreviewerService::AsyncService::
+          RequestUploadReference) {}
+
+PreviewerUploadReferenceCall::~PreviewerUploadReferenceCall() = default;
+
+std::unique_ptr<PreviewerUploadReferenceCallData>
+PreviewerUploadReferenceCall::clone() const {
+  return std::make_unique<PreviewerUploadReferenceCall>(
+    getService(), getQueue());
+}
+
+PreviewerUploadReferenceCall::ProcessResult
+PreviewerUploadReferenceCall::process(const Request &request) const {
+  const auto [status, hash] = addReference(request.image());
+  if (!status.ok()) return {status, {}};
+
+  specter_proto::ReferenceImageId response;
+  response.set_hash(hash.toStdString());
+  return {grpc::Status::OK, response};
+}
+
+/* -------------------------- PreviewerCompareImageCall --------------------- */
+
+PreviewerCompareImageCall::PreviewerCompareImageCall(
+  specter_proto::PreviewerService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : CallData(
+        service, queue, CallTag{this},
+        &specter_proto::PreviewerService::AsyncService::RequestCompareImage) {}
+
+PreviewerCompareImageCall::~PreviewerCompareImageCall() = default;
+
+std::unique_ptr<PreviewerCompareImageCallData>
+PreviewerCompareImageCall::clone() const {
+  return std::make_unique<PreviewerCompareImageCall>(getService(), getQueue());
+}
+
+PreviewerCompareImageCall::ProcessResult
+PreviewerCompareImageCall::process(const Request &request) const {
+  const auto id =
+    ObjectId::fromString(QString::fromStdString(request.object_id().id()));
+
+  auto [status, widget] = tryGetSingleWidget(id);
+  if (!status.ok()) return {status, {}};
+
+  auto hash = QString::fromStdString(request.reference_hash());
+  if (request.reference_case() == Request::kReferenceImage) {
+    auto [reference_status, reference_hash] =
+      addReference(request.reference_image());
+    if (!reference_status.ok()) return {reference_status, {}};
+
+    hash = std::move(reference_hash);
+  }
+
+  const auto reference = ImageComparator::findReference(hash);
+  if (!reference) {
+    return {
+      grpc::Status(
+        grpc::StatusCode::NOT_FOUND, "There is no reference image for hash"),
+      {}};
+  }
+
+  const auto region = request.has_region() ? toRect(request.region())
+                                           : widget->rect();
+  const auto actual = widget->grab(region).toImage();
+
+  const auto comparator =
+    ImageComparator(int(request.tolerance()), request.diff_mask());
+  const auto comparison = comparator.compare(actual, *reference);
+
+  specter_proto::ImageComparison response;
+  response.set_size_matches(comparison.size_matches);
+  response.set_similarity(comparison.similarity);
+  response.set_mismatched_pixels(comparison.mismatched_pixels);
+  for (const auto &mismatch : comparison.mismatches) {
+    setRect(response.add_mismatches(), mismatch);
+  }
+
+  if (!comparison.diff_mask.isNull()) {
+    auto format = PreviewFormat{};
+    if (request.has_mask_size()) {
+      format.max_size = QSize(
+        int(request.mask_size().width()), int(request.mask_size().height()));
+    }
+
+    const auto mask = PreviewEncoder::encode(comparison.diff_mask, format);
+    response.set_diff_mask(mask.data.constData(), mask.data.size());
+  }
+
+  return {grpc::Status::OK, response};
+}
+
+/* ----------------------- PreviewerStartRecordingCall ---------------------- */
+
+PreviewerStartRecordingCall::PreviewerStartRecordingCall(
+  specter_proto::PreviewerService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : CallData(
+        service, queue, CallTag{this},
+        &specter_proto::PreviewerService::AsyncService::
+          RequestStartRecording) {}
+
+PreviewerStartRecordingCall::~PreviewerStartRecordingCall() = default;
+
+std::unique_ptr<PreviewerStartRecordingCallData>
+PreviewerStartRecordingCall::clone() const {
+  return std::make_unique<PreviewerStartRecordingCall>(
+    getService(), getQueue());
+}
+
+PreviewerStartRecordingCall::ProcessResult
+PreviewerStartRecordingCall::process(const Request &request) const {
+  const auto id =
+    ObjectId::fromString(QString::fromStdString(request.object_id().id()));
+
+  auto [status, widget] = tryGetSingleWidget(id);
+  if (!status.ok()) return {status, {}};
+
+  if (!QDir().mkpath(PreviewRecording::getDirectory())) {
+    return {
+      grpc::Status(
+        grpc::StatusCode::FAILED_PRECONDITION,
+        "The recording directory cannot be created"),
+      {}};
+  }
+
+  const auto recording_id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+  const auto path = PreviewRecording::getRecordingPath(recording_id);
+
+  auto format = encodingFormat(request);
+  if (request.has_keyframe_interval()) {
+    format.keyframe_interval = int(request.keyframe_interval());
+  }
+
+  auto recording = std::make_unique<PreviewRecording>(path);
+  if (!recording->start(widget, format, request.max_fps())) {
+    return {
+      grpc::Status(
+        grpc::StatusCode::FAILED_PRECONDITION,
+        recording->getErrorString().toStdString()),
+      {}};
+  }
+
+  getRecordings().emplace(recording_id, std::move(recording));
+
+  specter_proto::Recording response;
+  response.set_recording_id(recording_id.toStdString());
+  response.set_path(path.toStdString());
+  return {grpc::Status::OK, response};
+}
+
+/* ----------------------- PreviewerStopRecordingCall ----------------------- */
+
+PreviewerStopRecordingCall::PreviewerStopRecordingCall(
+  specter_proto::PreviewerService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : CallData(
+        service, queue, CallTag{this},
+        &specter_proto::PreviewerService::AsyncService::RequestStopRecording) {
+}
+
+PreviewerStopRecordingCall::~PreviewerStopRecordingCall() = default;
+
+std::unique_ptr<PreviewerStopRecordingCallData>
+PreviewerStopRecordingCall::clone() const {
+  return std::make_unique<PreviewerStopRecordingCall>(
+    getService(), getQueue());
+}
+
+PreviewerStopRecordingCall::ProcessResult
+PreviewerStopRecordingCall::process(const Request &request) const {
+  const auto erased =
+    getRecordings().erase(QString::fromStdString(request.recording_id()));
+  if (erased == 0) {
+    return {
+      grpc::Status(
+        grpc::StatusCode::INVALID_ARGUMENT,
+        "There is no recording for passed id"),
+      {}};
+  }
+
+  return {grpc::Status::OK, {}};
+}
+
+/* --------------------- PreviewerReadRecordedFrameCall --------------------- */
+
+PreviewerReadRecordedFrameCall::PreviewerReadRecordedFrameCall(
+  specter_proto::PreviewerService::AsyncService *service,
+  grpc::ServerCompletionQueue *queue)
+    : AsyncCallData(
+        service, queue, CallTag{this},
+        &specter_proto::PreviewerService::AsyncService::
+          RequestReadRecordedFrame) {}
+
+PreviewerReadRecordedFrameCall::~PreviewerReadRecordedFrameCall() = default;
+
+std::unique_ptr<PreviewerReadRecordedFrameCallData>
+PreviewerReadRecordedFrameCall::clone() const {
+  return std::make_unique<PreviewerReadRecordedFrameCall>(
+    getService(), getQueue());
+}
+
+void PreviewerReadRecordedFrameCall::process(
+  const Request &request, Finisher finish) const {
+  const auto recording_id = QString::fromStdString(request.recording_id());
+  const auto uuid = QUuid::fromString(recording_id);
+  if (uuid.isNull() || uuid.toString(QUuid::WithoutBraces) != recording_id) {
+    finish(
+      {grpc::Status(
+         grpc::StatusCode::INVALID_ARGUMENT,
+         "There is no recording for passed id"),
+       {}});
+    return;
+  }
+
+  auto format = PreviewFormat{};
+  format.codec = static_cast<PreviewCodec>(request.codec());
+  format.quality = request.has_quality() ? int(request.quality()) : -1;
+
+  QThreadPool::globalInstance()->start(
+    [path = PreviewRecording::getRecordingPath(recording_id),
+     timestamp = request.timestamp_msecs(), format,
+     finish = std::move(finish)]() {
+      finish(readRecordedFrame(path, timestamp, format));
+    });
+}
+
 /* ------------------------------ PreviewerService -------------------------- */
 
 PreviewerService::PreviewerService() = default;
@@ -65,7 +608,23 @@ PreviewerService::~PreviewerService() = default;
 
 void PreviewerService::start(grpc::ServerCompletionQueue *queue) {
   auto listen_call = new PreviewerListenCommandsCall(this, queue);
+  auto force_keyframe_call = new PreviewerForceKeyframeCall(this, queue);
+  auto screenshot_call = new PreviewerScreenshotCall(this, queue);
+  auto upload_reference_call = new PreviewerUploadReferenceCall(this, queue);
+  auto compare_image_call = new PreviewerCompareImageCall(this, queue);
+  auto start_recording_call = new PreviewerStartRecordingCall(this, queue);
+  auto stop_recording_call = new PreviewerStopRecordingCall(this, queue);
+  auto read_recorded_frame_call =
+    new PreviewerReadRecordedFrameCall(this, queue);
+
   listen_call->proceed();
+  force_keyframe_call->proceed();
+  screenshot_call->proceed();
+  upload_reference_call->proceed();
+  compare_image_call->proceed();
+  start_recording_call->proceed();
+  stop_recording_call->proceed();
+  read_recorded_frame_call->proceed();
 }
 
 }// namespace specter
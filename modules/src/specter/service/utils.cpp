@@ -2,6 +2,7 @@
 #include "specter/service/utils.h"
 
 #include "specter/module.h"
+#include "specter/reflect/cache.h"
 /* ------------------------------------ Qt ---------------------------------- */
 #include <QColor>
 #include <QDateTime>
@@ -9,173 +10,257 @@
 #include <QMetaProperty>
 #include <QPoint>
 #include <QRect>
+#include <QSet>
 /* -------------------------------------------------------------------------- */
 
 namespace {
 
-google::protobuf::Value convertQtBaseTypeIntoValue(const QVariant &variant) {
-  google::protobuf::Value value;
+const int max_object_depth = 2;
 
-  int typeId = variant.typeId();
+struct ConversionContext {
+  int object_depth = 0;
+  QSet<const QObject *> objects = {};
+};
 
-  switch (typeId) {
-    case QMetaType::QString:
-      value.set_string_value(variant.toString().toStdString());
-      return value;
+using ValueConverter =
+  google::protobuf::Value (*)(const QVariant &, ConversionContext &);
 
-    case QMetaType::Bool:
-      value.set_bool_value(variant.toBool());
-      return value;
+google::protobuf::Value
+convertIntoValue(const QVariant &variant, ConversionContext &context);
 
-    case QMetaType::Int:
-    case QMetaType::UInt:
-    case QMetaType::LongLong:
-    case QMetaType::ULongLong:
-    case QMetaType::Double:
-    case QMetaType::Float:
-      value.set_number_value(variant.toDouble());
-      return value;
-  }
+google::protobuf::Value makeTypedValue(const char *type) {
+  auto value = google::protobuf::Value{};
+  (*value.mutable_struct_value()->mutable_fields())["type"].set_string_value(
+    type);
+  return value;
+}
 
-  if (variant.canConvert<QRect>()) {
-    QRect r = variant.toRect();
-    auto s = value.mutable_struct_value();
-    (*s->mutable_fields())["type"].set_string_value("QRect");
-    (*s->mutable_fields())["x"].set_number_value(r.x());
-    (*s->mutable_fields())["y"].set_number_value(r.y());
-    (*s->mutable_fields())["width"].set_number_value(r.width());
-    (*s->mutable_fields())["height"].set_number_value(r.height());
-    return value;
-  }
+google::protobuf::Value
+convertNullIntoValue(const QVariant &, ConversionContext &) {
+  return {};
+}
 
-  if (variant.canConvert<QPoint>()) {
-    QPoint p = variant.toPoint();
-    auto s = value.mutable_struct_value();
-    (*s->mutable_fields())["type"].set_string_value("QPoint");
-    (*s->mutable_fields())["x"].set_number_value(p.x());
-    (*s->mutable_fields())["y"].set_number_value(p.y());
-    return value;
-  }
+google::protobuf::Value
+convertStringIntoValue(const QVariant &variant, ConversionContext &) {
+  auto value = google::protobuf::Value{};
+  value.set_string_value(variant.toString().toStdString());
+  return value;
+}
 
-  if (variant.canConvert<QSize>()) {
-    QSize sz = variant.toSize();
-    auto s = value.mutable_struct_value();
-    (*s->mutable_fields())["type"].set_string_value("QSize");
-    (*s->mutable_fields())["width"].set_number_value(sz.width());
-    (*s->mutable_fields())["height"].set_number_value(sz.height());
-    return value;
-  }
+google::protobuf::Value
+convertBoolIntoValue(const QVariant &variant, ConversionContext &) {
+  auto value = google::protobuf::Value{};
+  value.set_bool_value(variant.toBool());
+  return value;
+}
 
-  if (variant.canConvert<QDateTime>()) {
-    QDateTime dt = variant.toDateTime();
-    auto s = value.mutable_struct_value();
-    (*s->mutable_fields())["type"].set_string_value("QDateTime");
-    (*s->mutable_fields())["iso"].set_string_value(
-      dt.toString(Qt::ISODate).toStdString());
-    return value;
-  }
+google::protobuf::Value
+convertNumberIntoValue(const QVariant &variant, ConversionContext &) {
+  auto value = google::protobuf::Value{};
+  value.set_number_value(variant.toDouble());
+  return value;
+}
 
-  if (variant.canConvert<QDate>()) {
-    QDate d = variant.toDate();
-    auto s = value.mutable_struct_value();
-    (*s->mutable_fields())["type"].set_string_value("QDate");
-    (*s->mutable_fields())["iso"].set_string_value(
-      d.toString(Qt::ISODate).toStdString());
-    return value;
-  }
+google::protobuf::Value
+convertRectIntoValue(const QVariant &variant, ConversionContext &) {
+  const auto rect = variant.toRect();
+  auto value = makeTypedValue("QRect");
+  auto &fields = *value.mutable_struct_value()->mutable_fields();
+  fields["x"].set_number_value(rect.x());
+  fields["y"].set_number_value(rect.y());
+  fields["width"].set_number_value(rect.width());
+  fields["height"].set_number_value(rect.height());
+  return value;
+}
 
-  if (variant.canConvert<QTime>()) {
-    QTime t = variant.toTime();
-    auto s = value.mutable_struct_value();
-    (*s->mutable_fields())["type"].set_string_value("QTime");
-    (*s->mutable_fields())["iso"].set_string_value(
-      t.toString(Qt::ISODate).toStdString());
-    return value;
+google::protobuf::Value
+convertPointIntoValue(const QVariant &variant, ConversionContext &) {
+  const auto point = variant.toPoint();
+  auto value = makeTypedValue("QPoint");
+  auto &fields = *value.mutable_struct_value()->mutable_fields();
+  fields["x"].set_number_value(point.x());
+  fields["y"].set_number_value(point.y());
+  return value;
+}
+
+google::protobuf::Value
+convertSizeIntoValue(const QVariant &variant, ConversionContext &) {
+  const auto size = variant.toSize();
+  auto value = makeTypedValue("QSize");
+  auto &fields = *value.mutable_struct_value()->mutable_fields();
+  fields["width"].set_number_value(size.width());
+  fields["height"].set_number_value(size.height());
+  return value;
+}
+
+google::protobuf::Value
+convertDateTimeIntoValue(const QVariant &variant, ConversionContext &) {
+  auto value = makeTypedValue("QDateTime");
+  (*value.mutable_struct_value()->mutable_fields())["iso"].set_string_value(
+    variant.toDateTime().toString(Qt::ISODate).toStdString());
+  return value;
+}
+
+google::protobuf::Value
+convertDateIntoValue(const QVariant &variant, ConversionContext &) {
+  auto value = makeTypedValue("QDate");
+  (*value.mutable_struct_value()->mutable_fields())["iso"].set_string_value(
+    variant.toDate().toString(Qt::ISODate).toStdString());
+  return value;
+}
+
+google::protobuf::Value
+convertTimeIntoValue(const QVariant &variant, ConversionContext &) {
+  auto value = makeTypedValue("QTime");
+  (*value.mutable_struct_value()->mutable_fields())["iso"].set_string_value(
+    variant.toTime().toString(Qt::ISODate).toStdString());
+  return value;
+}
+
+google::protobuf::Value
+convertColorIntoValue(const QVariant &variant, ConversionContext &) {
+  auto value = makeTypedValue("QColor");
+  (*value.mutable_struct_value()->mutable_fields())["rgba"].set_string_value(
+    variant.value<QColor>().name(QColor::HexArgb).toStdString());
+  return value;
+}
+
+google::protobuf::Value
+convertListIntoValue(const QVariant &variant, ConversionContext &context) {
+  auto value = google::protobuf::Value{};
+  auto list_value = value.mutable_list_value();
+  for (const auto &item : variant.toList()) {
+    *list_value->add_values() = convertIntoValue(item, context);
   }
 
-  if (variant.canConvert<QColor>()) {
-    QColor c = variant.value<QColor>();
-    auto s = value.mutable_struct_value();
-    (*s->mutable_fields())["type"].set_string_value("QColor");
-    (*s->mutable_fields())["rgba"].set_string_value(
-      c.name(QColor::HexArgb).toStdString());
-    return value;
+  return value;
+}
+
+google::protobuf::Value
+convertMapIntoValue(const QVariant &variant, ConversionContext &context) {
+  auto value = google::protobuf::Value{};
+  auto &fields = *value.mutable_struct_value()->mutable_fields();
+
+  const auto map = variant.toMap();
+  for (auto iter = map.begin(); iter != map.end(); ++iter) {
+    fields[iter.key().toStdString()] = convertIntoValue(iter.value(), context);
   }
 
-  if (typeId == QMetaType::QVariantList) {
-    auto list = variant.toList();
-    auto list_value = value.mutable_list_value();
-    for (const auto &item : list)
-      *list_value->add_values() = specter::convertIntoValue(item);
+  return value;
+}
+
+google::protobuf::Value
+convertObjectIntoValue(const QVariant &variant, ConversionContext &context) {
+  const auto object = variant.value<QObject *>();
+  if (!object) return {};
+
+  const auto meta_object = object->metaObject();
+  auto value = makeTypedValue(meta_object->className());
+  auto &fields = *value.mutable_struct_value()->mutable_fields();
+  fields["object_id"].set_string_value(
+    specter::searcher().getId(object).toString().toStdString());
+
+  if (
+    context.object_depth >= max_object_depth ||
+    context.objects.contains(object)) {
     return value;
   }
 
-  if (typeId == QMetaType::QVariantMap) {
-    auto map = variant.toMap();
-    auto struct_value = value.mutable_struct_value();
-    for (auto it = map.begin(); it != map.end(); ++it)
-      (*struct_value->mutable_fields())[it.key().toStdString()] =
-        specter::convertIntoValue(it.value());
-    return value;
+  ++context.object_depth;
+  context.objects.insert(object);
+
+  const auto &reflection = specter::ReflectionCache::get(meta_object);
+  for (const auto &property : reflection.getProperties()) {
+    if (!property.readable) continue;
+    fields[property.name.toStdString()] =
+      convertIntoValue(property.property.read(object), context);
   }
 
+  context.objects.remove(object);
+  --context.object_depth;
+
   return value;
 }
 
-google::protobuf::Value convertQtObjectTypeIntoValue(const QVariant &variant) {
-  google::protobuf::Value value;
-
-  if (variant.canConvert<QObject *>()) {
-    QObject *obj = variant.value<QObject *>();
-    if (obj) {
-      const QMetaObject *mo = obj->metaObject();
-      auto struct_value = value.mutable_struct_value();
-      (*struct_value->mutable_fields())["type"] =
-        specter::convertIntoValue(QString(mo->className()));
-
-      for (int i = 0; i < mo->propertyCount(); ++i) {
-        QMetaProperty prop = mo->property(i);
-        if (prop.isReadable()) {
-          QString name = prop.name();
-          QVariant propValue = prop.read(obj);
-          (*struct_value->mutable_fields())[name.toStdString()] =
-            specter::convertIntoValue(propValue);
-        }
-      }
-      return value;
-    }
+google::protobuf::Value
+convertGadgetIntoValue(const QVariant &variant, ConversionContext &context) {
+  const auto meta_object = variant.metaType().metaObject();
+  auto value = makeTypedValue(meta_object->className());
+  auto &fields = *value.mutable_struct_value()->mutable_fields();
+
+  const auto &reflection = specter::ReflectionCache::get(meta_object);
+  for (const auto &property : reflection.getProperties()) {
+    if (!property.readable) continue;
+    fields[property.name.toStdString()] = convertIntoValue(
+      property.property.readOnGadget(variant.constData()), context);
   }
 
   return value;
 }
 
-google::protobuf::Value convertQtGadgetTypeIntoValue(const QVariant &variant) {
-  google::protobuf::Value value;
+const QList<QPair<QMetaType, ValueConverter>> &getConvertibleTypes() {
+  static const auto convertible_types =
+    QList<QPair<QMetaType, ValueConverter>>{
+      {QMetaType::fromType<QRect>(), convertRectIntoValue},
+      {QMetaType::fromType<QPoint>(), convertPointIntoValue},
+      {QMetaType::fromType<QSize>(), convertSizeIntoValue},
+      {QMetaType::fromType<QDateTime>(), convertDateTimeIntoValue},
+      {QMetaType::fromType<QDate>(), convertDateIntoValue},
+      {QMetaType::fromType<QTime>(), convertTimeIntoValue},
+      {QMetaType::fromType<QColor>(), convertColorIntoValue}};
+  return convertible_types;
+}
 
-  int typeId = variant.typeId();
-  const QMetaType metaType(typeId);
+ValueConverter resolveValueConverter(const QMetaType &meta_type) {
+  for (const auto &[convertible_type, converter] : getConvertibleTypes()) {
+    if (QMetaType::canConvert(meta_type, convertible_type)) return converter;
+  }
 
-  if (metaType.flags().testFlag(QMetaType::IsGadget)) {
-    const QMetaObject *mo = QMetaType(typeId).metaObject();
-    if (mo) {
-      void *ptr = const_cast<void *>(variant.constData());
-      auto struct_value = value.mutable_struct_value();
-      (*struct_value->mutable_fields())["type"] =
-        specter::convertIntoValue(QString(mo->className()));
+  const auto flags = meta_type.flags();
+  if (flags.testFlag(QMetaType::PointerToQObject)) {
+    return convertObjectIntoValue;
+  }
 
-      for (int i = 0; i < mo->propertyCount(); ++i) {
-        QMetaProperty prop = mo->property(i);
-        if (prop.isReadable()) {
-          QVariant propValue = prop.readOnGadget(ptr);
-          (*struct_value->mutable_fields())[prop.name()] =
-            specter::convertIntoValue(propValue);
-        }
-      }
-      return value;
-    }
+  if (flags.testFlag(QMetaType::IsGadget) && meta_type.metaObject()) {
+    return convertGadgetIntoValue;
   }
 
-  return value;
+  return convertNullIntoValue;
+}
+
+ValueConverter getValueConverter(const QMetaType &meta_type) {
+  static auto converters = QHash<int, ValueConverter>{
+    {QMetaType::QString, convertStringIntoValue},
+    {QMetaType::Bool, convertBoolIntoValue},
+    {QMetaType::Int, convertNumberIntoValue},
+    {QMetaType::UInt, convertNumberIntoValue},
+    {QMetaType::LongLong, convertNumberIntoValue},
+    {QMetaType::ULongLong, convertNumberIntoValue},
+    {QMetaType::Double, convertNumberIntoValue},
+    {QMetaType::Float, convertNumberIntoValue},
+    {QMetaType::QRect, convertRectIntoValue},
+    {QMetaType::QPoint, convertPointIntoValue},
+    {QMetaType::QSize, convertSizeIntoValue},
+    {QMetaType::QDateTime, convertDateTimeIntoValue},
+    {QMetaType::QDate, convertDateIntoValue},
+    {QMetaType::QTime, convertTimeIntoValue},
+    {QMetaType::QColor, convertColorIntoValue},
+    {QMetaType::QVariantList, convertListIntoValue},
+    {QMetaType::QVariantMap, convertMapIntoValue}};
+
+  auto converter = converters.constFind(meta_type.id());
+  if (converter == converters.constEnd()) {
+    converter =
+      converters.insert(meta_type.id(), resolveValueConverter(meta_type));
+  }
+
+  return *converter;
+}
+
+google::protobuf::Value
+convertIntoValue(const QVariant &variant, ConversionContext &context) {
+  const auto converter = getValueConverter(variant.metaType());
+  return converter(variant, context);
 }
 
 QVariant convertBaseTypeIntoVariant(const google::protobuf::Value &value) {
@@ -268,14 +353,14 @@ QVariant convertStructTypeIntoVariant(const google::protobuf::Value &value) {
 
         if (metaType.flags().testFlag(QMetaType::IsGadget)) {
           void *ptr = metaType.create();
-          const QMetaObject *mo = metaType.metaObject();
+          const auto &reflection =
+            specter::ReflectionCache::get(metaType.metaObject());
 
-          for (int i = 0; i < mo->propertyCount(); ++i) {
-            QMetaProperty prop = mo->property(i);
-            auto it = fields.find(prop.name());
+          for (const auto &property : reflection.getProperties()) {
+            auto it = fields.find(property.name.toStdString());
             if (it != fields.end()) {
               QVariant propValue = specter::convertIntoVariant(it->second);
-              prop.writeOnGadget(ptr, propValue);
+              property.property.writeOnGadget(ptr, propValue);
             }
           }
 
@@ -314,18 +399,199 @@ QVariant convertIntoVariant(const google::protobuf::Value &value) {
 }
 
 google::protobuf::Value convertIntoValue(const QVariant &variant) {
-  auto value = google::protobuf::Value{};
+  auto context = ConversionContext{};
+  return ::convertIntoValue(variant, context);
+}
 
-  if (value = convertQtBaseTypeIntoValue(variant); !value.null_value())
-    return value;
-  if (value = convertQtObjectTypeIntoValue(variant); !value.null_value())
-    return value;
-  if (value = convertQtGadgetTypeIntoValue(variant); !value.null_value())
-    return value;
+QVariant convertIntoVariant(const specter_proto::SpecterValue &value) {
+  using KindCase = specter_proto::SpecterValue::KindCase;
+
+  switch (value.kind_case()) {
+    case KindCase::kBoolValue:
+      return QVariant::fromValue(value.bool_value());
+
+    case KindCase::kIntValue:
+      return QVariant::fromValue(qlonglong(value.int_value()));
+
+    case KindCase::kUintValue:
+      return QVariant::fromValue(qulonglong(value.uint_value()));
+
+    case KindCase::kDoubleValue:
+      return QVariant::fromValue(value.double_value());
+
+    case KindCase::kStringValue:
+      return QVariant::fromValue(QString::fromStdString(value.string_value()));
+
+    case KindCase::kBytesValue:
+      return QVariant::fromValue(
+        QByteArray::fromStdString(value.bytes_value()));
+
+    case KindCase::kRectValue: {
+      const auto &rect = value.rect_value();
+      return QRect(rect.x(), rect.y(), rect.width(), rect.height());
+    }
+
+    case KindCase::kPointValue:
+      return QPoint(value.point_value().x(), value.point_value().y());
+
+    case KindCase::kSizeValue:
+      return QSize(value.size_value().width(), value.size_value().height());
+
+    case KindCase::kArgbValue:
+      return QColor::fromRgba(value.argb_value());
+
+    case KindCase::kDateTimeMsecs:
+      return QDateTime::fromMSecsSinceEpoch(value.date_time_msecs());
+
+    case KindCase::kDateJulianDay:
+      return QDate::fromJulianDay(value.date_julian_day());
+
+    case KindCase::kTimeMsecs:
+      return QTime::fromMSecsSinceStartOfDay(int(value.time_msecs()));
+
+    case KindCase::kListValue: {
+      auto list = QVariantList{};
+      list.reserve(value.list_value().values_size());
+      for (const auto &item : value.list_value().values()) {
+        list.append(convertIntoVariant(item));
+      }
+      return list;
+    }
+
+    case KindCase::kMapValue: {
+      auto map = QVariantMap{};
+      for (const auto &[key, item] : value.map_value().fields()) {
+        map.insert(QString::fromStdString(key), convertIntoVariant(item));
+      }
+      return map;
+    }
+
+    case KindCase::kGenericValue:
+      return convertIntoVariant(value.generic_value());
+
+    case KindCase::KIND_NOT_SET:
+      break;
+  }
+
+  return {};
+}
+
+specter_proto::SpecterValue convertIntoSpecterValue(const QVariant &variant) {
+  auto value = specter_proto::SpecterValue{};
+
+  switch (variant.typeId()) {
+    case QMetaType::UnknownType:
+      break;
+
+    case QMetaType::Bool:
+      value.set_bool_value(variant.toBool());
+      break;
+
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::LongLong:
+      value.set_int_value(variant.toLongLong());
+      break;
+
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+      value.set_uint_value(variant.toULongLong());
+      break;
+
+    case QMetaType::Double:
+    case QMetaType::Float:
+      value.set_double_value(variant.toDouble());
+      break;
+
+    case QMetaType::QString:
+      value.set_string_value(variant.toString().toStdString());
+      break;
+
+    case QMetaType::QByteArray:
+      value.set_bytes_value(variant.toByteArray().toStdString());
+      break;
+
+    case QMetaType::QRect: {
+      const auto rect = variant.toRect();
+      auto rect_value = value.mutable_rect_value();
+      rect_value->set_x(rect.x());
+      rect_value->set_y(rect.y());
+      rect_value->set_width(rect.width());
+      rect_value->set_height(rect.height());
+      break;
+    }
+
+    case QMetaType::QPoint: {
+      const auto point = variant.toPoint();
+      value.mutable_point_value()->set_x(point.x());
+      value.mutable_point_value()->set_y(point.y());
+      break;
+    }
+
+    case QMetaType::QSize: {
+      const auto size = variant.toSize();
+      value.mutable_size_value()->set_width(size.width());
+      value.mutable_size_value()->set_height(size.height());
+      break;
+    }
+
+    case QMetaType::QColor:
+      value.set_argb_value(variant.value<QColor>().rgba());
+      break;
+
+    case QMetaType::QDateTime:
+      value.set_date_time_msecs(variant.toDateTime().toMSecsSinceEpoch());
+      break;
+
+    case QMetaType::QDate:
+      value.set_date_julian_day(variant.toDate().toJulianDay());
+      break;
+
+    case QMetaType::QTime:
+      value.set_time_msecs(variant.toTime().msecsSinceStartOfDay());
+      break;
+
+    case QMetaType::QVariantList:
+    case QMetaType::QStringList: {
+      auto list_value = value.mutable_list_value();
+      for (const auto &item : variant.toList()) {
+        *list_value->add_values() = convertIntoSpecterValue(item);
+      }
+      break;
+    }
+
+    case QMetaType::QVariantMap: {
+      auto &fields = *value.mutable_map_value()->mutable_fields();
+      const auto map = variant.toMap();
+      for (auto iter = map.begin(); iter != map.end(); ++iter) {
+        fields[iter.key().toStdString()] =
+          convertIntoSpecterValue(iter.value());
+      }
+      break;
+    }
+
+    default:
+      *value.mutable_generic_value() = convertIntoValue(variant);
+      break;
+  }
 
   return value;
 }
 
+QStringList convertIntoStringList(
+  const google::protobuf::RepeatedPtrField<std::string> &strings) {
+  auto string_list = QStringList{};
+  string_list.reserve(strings.size());
+  for (const auto &string : strings) {
+    string_list.append(QString::fromStdString(string));
+  }
+
+  return string_list;
+}
+
 std::pair<grpc::Status, QObjectList> tryGetObjects(const ObjectQuery &query) {
   return {grpc::Status::OK, searcher().getObjects(query)};
 }